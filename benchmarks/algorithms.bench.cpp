@@ -0,0 +1,73 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <type_traits>
+
+#include "algorithms.hpp"
+
+/*
+* Compares my_vec::algorithms::sort (radix sort for arithmetic elements) with
+* std::sort on the same random input. Every measurement is the median of
+* several runs, each run sorts a fresh copy of the input.
+*/
+
+constexpr std::size_t defaultBenchmarkSize = 10'000'000;
+constexpr std::size_t benchmarkRuns = 5;
+
+template <typename T>
+my_vec::vector<T> makeRandomVector(std::size_t size)
+{
+    std::mt19937_64 engine { 42 };
+    my_vec::vector<T> vec;
+    vec.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        if constexpr (std::is_floating_point_v<T>) {
+            vec.push_back(std::uniform_real_distribution<T> { -1e9, 1e9 }(engine));
+        } else {
+            vec.push_back(static_cast<T>(engine()));
+        }
+    }
+    return vec;
+}
+
+template <typename Sort>
+double medianMilliseconds(const auto& input, Sort sort)
+{
+    std::array<double, benchmarkRuns> timings {};
+    for (auto& timing : timings) {
+        auto vec = input;
+        const auto start = std::chrono::steady_clock::now();
+        sort(vec);
+        timing = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (!std::is_sorted(vec.begin(), vec.end())) {
+            std::cerr << "sort produced unsorted output\n";
+            std::exit(1);
+        }
+    }
+    std::sort(timings.begin(), timings.end());
+    return timings[benchmarkRuns / 2];
+}
+
+template <typename T>
+void benchmarkSort(const std::string& name, std::size_t size)
+{
+    const auto input = makeRandomVector<T>(size);
+    const auto radix = medianMilliseconds(input, [](auto& vec) { my_vec::algorithms::sort(vec); });
+    const auto standard = medianMilliseconds(input, [](auto& vec) { std::sort(vec.begin(), vec.end()); });
+    std::cout << name << " x " << size << ": algorithms::sort " << radix << " ms, std::sort " << standard
+              << " ms, speedup " << standard / radix << "x\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const auto size = argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : defaultBenchmarkSize;
+    benchmarkSort<std::int32_t>("int32", size);
+    benchmarkSort<std::uint64_t>("uint64", size);
+    benchmarkSort<double>("double", size);
+}
@@ -0,0 +1,76 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "concurrent_vector.hpp"
+#include "vector.hpp"
+
+/*
+* Appends the same number of elements from 1 to 64 threads into
+* concurrent_vector and into mutex guarded vector. Every thread pushes its
+* share of elements, reported time covers starting and joining all threads.
+*/
+
+constexpr std::size_t defaultBenchmarkElements = 10'000'000;
+constexpr std::size_t maxBenchmarkThreads = 64;
+
+class mutex_vector {
+public:
+    void push_back(std::size_t value)
+    {
+        std::lock_guard lock { mutex_ };
+        values_.push_back(value);
+    }
+
+    std::size_t size()
+    {
+        std::lock_guard lock { mutex_ };
+        return values_.size();
+    }
+
+private:
+    std::mutex mutex_;
+    my_vec::vector<std::size_t> values_;
+};
+
+template <typename Vector>
+double pushMilliseconds(std::size_t elements, std::size_t numOfThreads)
+{
+    Vector vec;
+    const auto perThread = elements / numOfThreads;
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> producers;
+    for (std::size_t t = 0; t < numOfThreads; ++t) {
+        producers.emplace_back([&vec, perThread, t] {
+            for (std::size_t i = 0; i < perThread; ++i) {
+                vec.push_back(t * perThread + i);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    if (vec.size() != perThread * numOfThreads) {
+        std::cerr << "elements were lost\n";
+        std::exit(1);
+    }
+    return elapsed;
+}
+
+int main(int argc, char* argv[])
+{
+    const auto elements = argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : defaultBenchmarkElements;
+    for (std::size_t numOfThreads = 1; numOfThreads <= maxBenchmarkThreads; numOfThreads *= 2) {
+        const auto concurrent = pushMilliseconds<my_vec::concurrent_vector<std::size_t>>(elements, numOfThreads);
+        const auto locked = pushMilliseconds<mutex_vector>(elements, numOfThreads);
+        std::cout << numOfThreads << " threads x " << elements / numOfThreads << ": concurrent_vector " << concurrent
+                  << " ms, mutex + vector " << locked << " ms, speedup " << locked / concurrent << "x\n";
+    }
+}
@@ -0,0 +1,50 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "cow_vector.hpp"
+#include "tracking_allocator.hpp"
+
+/*
+* Fan-out workload: one source vector is copied to every consumer and all
+* copies are alive at the same time, a given share of consumers then writes
+* to its copy. Runs it with cow_vector and with vector, both on
+* tracking_allocator, and reports peak bytes and time.
+*/
+
+constexpr std::size_t defaultBenchmarkSize = 1'000'000;
+constexpr std::size_t benchmarkConsumers = 64;
+
+using tracked_allocator = my_alloc::tracking_allocator<my_alloc::allocator<std::uint64_t>>;
+
+template <typename Vector>
+void runFanOut(const std::string& name, std::size_t size, std::size_t writers)
+{
+    auto& registry = my_alloc::tracking_registry::instance();
+    registry.reset();
+
+    const auto start = std::chrono::steady_clock::now();
+    {
+        const Vector source(size, 1);
+        std::vector<Vector> consumers(benchmarkConsumers, source);
+        for (std::size_t i = 0; i < writers; ++i) {
+            consumers[i][0] = i;
+        }
+    }
+    const auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    const auto peak = registry.snapshot().highWaterBytes;
+    std::cout << name << " " << writers << "/" << benchmarkConsumers << " writers: peak "
+              << static_cast<double>(peak) / (1 << 20) << " MB, " << elapsed << " ms\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const auto size = argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : defaultBenchmarkSize;
+    for (const auto writers : { std::size_t { 0 }, benchmarkConsumers / 8, benchmarkConsumers }) {
+        runFanOut<my_vec::cow_vector<std::uint64_t, tracked_allocator>>("cow_vector", size, writers);
+        runFanOut<my_vec::vector<std::uint64_t, tracked_allocator>>("vector", size, writers);
+    }
+}
@@ -0,0 +1,75 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <unistd.h>
+
+#include "serialization.hpp"
+
+/*
+* Serializes vector of trivially copyable elements and vector<bool> with the
+* given payload size (1 GB by default) to file in temporary directory and
+* deserializes it back. Reported throughput counts payload bytes only and
+* includes flushing the stream, but not syncing the file to disk.
+*/
+
+constexpr std::size_t defaultBenchmarkMegabytes = 1024;
+
+using clock_type = std::chrono::steady_clock;
+
+double gigabytesPerSecond(std::size_t bytes, clock_type::time_point start)
+{
+    return static_cast<double>(bytes) / 1e9 / std::chrono::duration<double>(clock_type::now() - start).count();
+}
+
+template <typename Vector>
+void benchmarkRoundTrip(const std::string& name, const Vector& vec, std::size_t bytes, const std::string& path)
+{
+    auto start = clock_type::now();
+    {
+        std::ofstream out { path, std::ios::binary | std::ios::trunc };
+        my_vec::serialize(out, vec);
+        out.flush();
+    }
+    const auto written = gigabytesPerSecond(bytes, start);
+
+    Vector loaded;
+    start = clock_type::now();
+    {
+        std::ifstream in { path, std::ios::binary };
+        my_vec::deserialize(in, loaded);
+    }
+    const auto read = gigabytesPerSecond(bytes, start);
+    if (loaded != vec) {
+        std::cerr << "deserialized vector differs from serialized one\n";
+        std::exit(1);
+    }
+    std::cout << name << " " << bytes / (1 << 20) << " MB: serialize " << written << " GB/s, deserialize " << read << " GB/s\n";
+}
+
+int main(int argc, char* argv[])
+{
+    const auto megabytes = argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : defaultBenchmarkMegabytes;
+    const auto bytes = megabytes << 20;
+    const auto path = (std::filesystem::temp_directory_path() / ("serialization_bench_" + std::to_string(::getpid()) + ".bin")).string();
+    {
+        my_vec::vector<std::uint64_t> vec(bytes / sizeof(std::uint64_t), my_vec::default_init);
+        for (std::size_t i = 0; i < vec.size(); ++i) {
+            vec[i] = i * 0x9E3779B97F4A7C15ULL;
+        }
+        benchmarkRoundTrip("vector<uint64_t>", vec, bytes, path);
+    }
+    {
+        my_vec::vector<bool> vec(8 * bytes);
+        for (std::size_t i = 0; i < vec.size(); i += 7) {
+            vec[i] = true;
+        }
+        benchmarkRoundTrip("vector<bool>", vec, bytes, path);
+    }
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,124 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "spsc_queue.hpp"
+#include "vector.hpp"
+
+/*
+* Moves timestamps from one producer to one consumer thread through
+* spsc_queue and through mutex guarded vector, which consumer swaps out in
+* whole. Reports throughput and percentiles of time between push and pop.
+*/
+
+using clock_type = std::chrono::steady_clock;
+
+constexpr std::size_t defaultBenchmarkTransfers = 5'000'000;
+constexpr std::size_t benchmarkQueueCapacity = 1024;
+
+std::int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(clock_type::now().time_since_epoch()).count();
+}
+
+class mutex_queue {
+public:
+    void push(std::int64_t value)
+    {
+        std::lock_guard lock { mutex_ };
+        values_.push_back(value);
+    }
+
+    // Takes every queued value at once, so consumer holds lock only for swap.
+    void popAll(my_vec::vector<std::int64_t>& out)
+    {
+        out.clear();
+        std::lock_guard lock { mutex_ };
+        values_.swap(out);
+    }
+
+private:
+    std::mutex mutex_;
+    my_vec::vector<std::int64_t> values_;
+};
+
+void report(const std::string& name, std::vector<std::int64_t>& latencies, double seconds)
+{
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&latencies](double p) {
+        return latencies[std::min(latencies.size() - 1, static_cast<std::size_t>(p * static_cast<double>(latencies.size())))];
+    };
+    std::cout << name << ": " << static_cast<double>(latencies.size()) / seconds / 1e6 << " M transfers/s, latency ns"
+              << " p50=" << percentile(0.5) << " p99=" << percentile(0.99) << " p99.9=" << percentile(0.999)
+              << " max=" << latencies.back() << '\n';
+}
+
+void benchmarkSpscQueue(std::size_t transfers)
+{
+    my_vec::spsc_queue<std::int64_t> queue(benchmarkQueueCapacity);
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(transfers);
+
+    const auto start = clock_type::now();
+    std::thread producer([&queue, transfers] {
+        for (std::size_t i = 0; i < transfers;) {
+            if (queue.try_push(nowNs())) {
+                ++i;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+    std::int64_t stamp = 0;
+    while (latencies.size() < transfers) {
+        if (queue.try_pop(stamp)) {
+            latencies.push_back(nowNs() - stamp);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+    producer.join();
+    report("spsc_queue", latencies, std::chrono::duration<double>(clock_type::now() - start).count());
+}
+
+void benchmarkMutexQueue(std::size_t transfers)
+{
+    mutex_queue queue;
+    std::vector<std::int64_t> latencies;
+    latencies.reserve(transfers);
+
+    const auto start = clock_type::now();
+    std::thread producer([&queue, transfers] {
+        for (std::size_t i = 0; i < transfers; ++i) {
+            queue.push(nowNs());
+        }
+    });
+    my_vec::vector<std::int64_t> batch;
+    while (latencies.size() < transfers) {
+        queue.popAll(batch);
+        if (batch.empty()) {
+            std::this_thread::yield();
+            continue;
+        }
+        const auto now = nowNs();
+        for (const auto value : batch) {
+            latencies.push_back(now - value);
+        }
+    }
+    producer.join();
+    report("mutex + vector", latencies, std::chrono::duration<double>(clock_type::now() - start).count());
+}
+
+int main(int argc, char* argv[])
+{
+    const auto transfers = argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : defaultBenchmarkTransfers;
+    benchmarkSpscQueue(transfers);
+    benchmarkMutexQueue(transfers);
+}
@@ -0,0 +1,91 @@
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "vector.hpp"
+
+/*
+* Compares copy, fill and comparison of my_vec::vector, which use memcpy,
+* memset and memcmp for trivial elements, with generic std::uninitialized_copy,
+* std::uninitialized_fill and std::equal over the same number of elements.
+* Both sides allocate fresh storage for copy and fill, so page faults are paid
+* equally. Every measurement is the median of several runs.
+*/
+
+constexpr std::size_t defaultBenchmarkSize = 50'000'000;
+constexpr std::size_t benchmarkRuns = 5;
+
+template <typename Operation>
+double medianMilliseconds(Operation operation)
+{
+    std::array<double, benchmarkRuns> timings {};
+    for (auto& timing : timings) {
+        const auto start = std::chrono::steady_clock::now();
+        operation();
+        timing = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+    std::sort(timings.begin(), timings.end());
+    return timings[benchmarkRuns / 2];
+}
+
+void check(bool condition)
+{
+    if (!condition) {
+        std::cerr << "benchmarked operation produced wrong result\n";
+        std::exit(1);
+    }
+}
+
+void print(const std::string& name, const std::string& operation, double vectorTime, double genericTime)
+{
+    std::cout << name << " " << operation << ": vector " << vectorTime << " ms, generic " << genericTime
+              << " ms, speedup " << genericTime / vectorTime << "x\n";
+}
+
+template <typename T>
+void benchmarkElements(const std::string& name, std::size_t size)
+{
+    my_alloc::allocator<T> alloc;
+    const my_vec::vector<T> source(size, T { 1 });
+
+    const auto vectorCopy = medianMilliseconds([&source] {
+        const my_vec::vector<T> copy(source);
+        check(copy.back() == source.back());
+    });
+    const auto genericCopy = medianMilliseconds([&source, &alloc] {
+        T* copy = alloc.allocate(source.size());
+        std::uninitialized_copy(source.begin(), source.end(), copy);
+        check(copy[source.size() - 1] == source.back());
+        alloc.deallocate(copy, source.size());
+    });
+    print(name, "copy", vectorCopy, genericCopy);
+
+    const auto vectorFill = medianMilliseconds([size] {
+        const my_vec::vector<T> filled(size, T { 0 });
+        check(filled.back() == T { 0 });
+    });
+    const auto genericFill = medianMilliseconds([size, &alloc] {
+        T* filled = alloc.allocate(size);
+        std::uninitialized_fill(filled, filled + size, T { 0 });
+        check(filled[size - 1] == T { 0 });
+        alloc.deallocate(filled, size);
+    });
+    print(name, "fill", vectorFill, genericFill);
+
+    const my_vec::vector<T> other(source);
+    const auto vectorCompare = medianMilliseconds([&source, &other] { check(source == other); });
+    const auto genericCompare = medianMilliseconds([&source, &other] { check(std::equal(source.begin(), source.end(), other.begin())); });
+    print(name, "compare", vectorCompare, genericCompare);
+}
+
+int main(int argc, char* argv[])
+{
+    const auto size = argc > 1 ? static_cast<std::size_t>(std::stoull(argv[1])) : defaultBenchmarkSize;
+    benchmarkElements<char>("char", size);
+    benchmarkElements<int>("int", size);
+}
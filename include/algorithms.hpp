@@ -0,0 +1,380 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <type_traits>
+#include <utility>
+
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <immintrin.h>
+#endif
+
+#include "vector.hpp"
+
+namespace my_vec::algorithms {
+/*
+* Algorithms specialized for contiguous storage of vector.
+* sort of integral and floating point elements is LSD radix sort over order
+* preserving unsigned keys, one byte per pass, with scratch buffer taken from
+* vector's allocator; passes in which all elements share a digit are skipped.
+* find, count and min_max of integral elements use AVX2 kernels when CPU
+* supports them (checked once at runtime) and scalar loops otherwise.
+* lower_bound halves range with conditional moves instead of branches.
+*/
+
+namespace detail {
+    constexpr std::size_t radixSortThreshold = 256;
+    constexpr std::size_t radixBuckets = 256;
+
+    template <typename T>
+    concept isRadixSortable = (std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8)
+        || (std::is_floating_point_v<T> && std::numeric_limits<T>::is_iec559 && (sizeof(T) == 4 || sizeof(T) == 8));
+
+    template <typename T>
+    concept isSimdComparable = std::is_integral_v<T> && !std::is_same_v<T, bool> && sizeof(T) <= 8;
+
+    // AVX2 has min/max instructions only for elements up to 32 bits.
+    template <typename T>
+    concept isSimdOrdered = isSimdComparable<T> && sizeof(T) <= 4;
+
+    template <std::size_t Size>
+    struct radix_key;
+    template <>
+    struct radix_key<1> {
+        using type = std::uint8_t;
+    };
+    template <>
+    struct radix_key<2> {
+        using type = std::uint16_t;
+    };
+    template <>
+    struct radix_key<4> {
+        using type = std::uint32_t;
+    };
+    template <>
+    struct radix_key<8> {
+        using type = std::uint64_t;
+    };
+
+    template <typename T>
+    using radix_key_t = typename radix_key<sizeof(T)>::type;
+
+    // Maps value to unsigned key whose unsigned order is the order of values: sign bit is flipped
+    // for signed integers, for floating point negative values have all bits flipped.
+    template <typename T>
+    constexpr radix_key_t<T> toRadixKey(T value) noexcept
+    {
+        using key_t = radix_key_t<T>;
+        constexpr key_t signBit = static_cast<key_t>(key_t { 1 } << (8 * sizeof(key_t) - 1));
+        if constexpr (std::is_floating_point_v<T>) {
+            const auto bits = std::bit_cast<key_t>(value);
+            return (bits & signBit) != 0 ? static_cast<key_t>(~bits) : static_cast<key_t>(bits | signBit);
+        } else if constexpr (std::is_signed_v<T>) {
+            return static_cast<key_t>(static_cast<key_t>(value) ^ signBit);
+        } else {
+            return static_cast<key_t>(value);
+        }
+    }
+
+    template <typename T>
+    constexpr std::size_t radixDigit(T value, std::size_t pass) noexcept
+    {
+        return static_cast<std::size_t>((toRadixKey(value) >> (8 * pass)) & 0xffu);
+    }
+
+    template <typename T, typename Allocator, typename Stats>
+    void radixSort(vector<T, Allocator, Stats>& vec)
+    {
+        constexpr std::size_t numOfPasses = sizeof(T);
+        const auto count = vec.size();
+        T* elem = vec.data();
+
+        // Histograms of all passes are built in a single read of input.
+        std::array<std::array<std::size_t, radixBuckets>, numOfPasses> histograms {};
+        for (std::size_t i = 0; i < count; ++i) {
+            for (std::size_t pass = 0; pass < numOfPasses; ++pass) {
+                ++histograms[pass][radixDigit(elem[i], pass)];
+            }
+        }
+
+        auto alloc = vec.get_allocator();
+        T* scratch = alloc.allocate(count);
+        T* source = elem;
+        T* dest = scratch;
+        for (std::size_t pass = 0; pass < numOfPasses; ++pass) {
+            auto& offsets = histograms[pass];
+            if (offsets[radixDigit(source[0], pass)] == count) {
+                continue;
+            }
+            std::size_t offset = 0;
+            for (auto& bucket : offsets) {
+                offset += std::exchange(bucket, offset);
+            }
+            for (std::size_t i = 0; i < count; ++i) {
+                dest[offsets[radixDigit(source[i], pass)]++] = source[i];
+            }
+            std::swap(source, dest);
+        }
+        if (source != elem) {
+            std::memcpy(elem, source, count * sizeof(T));
+        }
+        alloc.deallocate(scratch, count);
+    }
+
+    template <typename T, typename U, typename Compare>
+    std::size_t lowerBoundIndex(const T* first, std::size_t count, const U& value, Compare& comp)
+    {
+        if (count == 0) {
+            return 0;
+        }
+        const T* base = first;
+        while (count > 1) {
+            const auto half = count / 2;
+#if defined(__GNUC__)
+            // Both possible probes of next step are fetched while comparison of this one is pending.
+            __builtin_prefetch(base + half / 2);
+            __builtin_prefetch(base + half + half / 2);
+#endif
+            base = std::invoke(comp, base[half], value) ? base + half : base;
+            count -= half;
+        }
+        return static_cast<std::size_t>(base - first) + (std::invoke(comp, *base, value) ? 1 : 0);
+    }
+
+    inline bool hasAvx2() noexcept
+    {
+#if defined(__x86_64__) && defined(__GNUC__)
+        static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+        return supported;
+#else
+        return false;
+#endif
+    }
+
+#if defined(__x86_64__) && defined(__GNUC__)
+    template <typename T>
+    __attribute__((target("avx2"))) inline __m256i avx2Broadcast(T value) noexcept
+    {
+        if constexpr (sizeof(T) == 1) {
+            return _mm256_set1_epi8(static_cast<char>(value));
+        } else if constexpr (sizeof(T) == 2) {
+            return _mm256_set1_epi16(static_cast<short>(value));
+        } else if constexpr (sizeof(T) == 4) {
+            return _mm256_set1_epi32(static_cast<int>(value));
+        } else {
+            return _mm256_set1_epi64x(static_cast<long long>(value));
+        }
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) inline __m256i avx2Equal(__m256i lhs, __m256i rhs) noexcept
+    {
+        if constexpr (sizeof(T) == 1) {
+            return _mm256_cmpeq_epi8(lhs, rhs);
+        } else if constexpr (sizeof(T) == 2) {
+            return _mm256_cmpeq_epi16(lhs, rhs);
+        } else if constexpr (sizeof(T) == 4) {
+            return _mm256_cmpeq_epi32(lhs, rhs);
+        } else {
+            return _mm256_cmpeq_epi64(lhs, rhs);
+        }
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) inline __m256i avx2Min(__m256i lhs, __m256i rhs) noexcept
+    {
+        if constexpr (sizeof(T) == 1) {
+            return std::is_signed_v<T> ? _mm256_min_epi8(lhs, rhs) : _mm256_min_epu8(lhs, rhs);
+        } else if constexpr (sizeof(T) == 2) {
+            return std::is_signed_v<T> ? _mm256_min_epi16(lhs, rhs) : _mm256_min_epu16(lhs, rhs);
+        } else {
+            return std::is_signed_v<T> ? _mm256_min_epi32(lhs, rhs) : _mm256_min_epu32(lhs, rhs);
+        }
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) inline __m256i avx2Max(__m256i lhs, __m256i rhs) noexcept
+    {
+        if constexpr (sizeof(T) == 1) {
+            return std::is_signed_v<T> ? _mm256_max_epi8(lhs, rhs) : _mm256_max_epu8(lhs, rhs);
+        } else if constexpr (sizeof(T) == 2) {
+            return std::is_signed_v<T> ? _mm256_max_epi16(lhs, rhs) : _mm256_max_epu16(lhs, rhs);
+        } else {
+            return std::is_signed_v<T> ? _mm256_max_epi32(lhs, rhs) : _mm256_max_epu32(lhs, rhs);
+        }
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) inline __m256i avx2Load(const T* p) noexcept
+    {
+        return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) std::size_t findAvx2(const T* first, std::size_t count, T value) noexcept
+    {
+        constexpr std::size_t lanes = sizeof(__m256i) / sizeof(T);
+        const auto needle = avx2Broadcast(value);
+        std::size_t i = 0;
+        for (; i + lanes <= count; i += lanes) {
+            const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(avx2Equal<T>(avx2Load(first + i), needle)));
+            if (mask != 0) {
+                return i + static_cast<std::size_t>(std::countr_zero(mask)) / sizeof(T);
+            }
+        }
+        for (; i < count; ++i) {
+            if (first[i] == value) {
+                return i;
+            }
+        }
+        return count;
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) std::size_t countAvx2(const T* first, std::size_t count, T value) noexcept
+    {
+        constexpr std::size_t lanes = sizeof(__m256i) / sizeof(T);
+        const auto needle = avx2Broadcast(value);
+        // Every matching element sets sizeof(T) bits of mask.
+        std::size_t matchingBytes = 0;
+        std::size_t i = 0;
+        for (; i + lanes <= count; i += lanes) {
+            const auto mask = static_cast<std::uint32_t>(_mm256_movemask_epi8(avx2Equal<T>(avx2Load(first + i), needle)));
+            matchingBytes += static_cast<std::size_t>(std::popcount(mask));
+        }
+        auto result = matchingBytes / sizeof(T);
+        for (; i < count; ++i) {
+            result += first[i] == value ? 1 : 0;
+        }
+        return result;
+    }
+
+    template <typename T>
+    __attribute__((target("avx2"))) std::ranges::minmax_result<T> minMaxAvx2(const T* first, std::size_t count) noexcept
+    {
+        constexpr std::size_t lanes = sizeof(__m256i) / sizeof(T);
+        if (count < lanes) {
+            return std::ranges::minmax(std::ranges::subrange(first, first + count));
+        }
+        auto minimum = avx2Load(first);
+        auto maximum = minimum;
+        for (std::size_t i = lanes; i + lanes <= count; i += lanes) {
+            const auto chunk = avx2Load(first + i);
+            minimum = avx2Min<T>(minimum, chunk);
+            maximum = avx2Max<T>(maximum, chunk);
+        }
+        // Tail is covered by one load overlapping already processed elements, which does not change min or max.
+        const auto tail = avx2Load(first + count - lanes);
+        minimum = avx2Min<T>(minimum, tail);
+        maximum = avx2Max<T>(maximum, tail);
+
+        std::array<T, lanes> minLanes;
+        std::array<T, lanes> maxLanes;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(minLanes.data()), minimum);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(maxLanes.data()), maximum);
+        return { std::ranges::min(minLanes), std::ranges::max(maxLanes) };
+    }
+#endif
+
+    template <typename T>
+    std::size_t findIndex(const T* first, std::size_t count, const T& value)
+    {
+#if defined(__x86_64__) && defined(__GNUC__)
+        if constexpr (isSimdComparable<T>) {
+            if (hasAvx2()) {
+                return findAvx2(first, count, value);
+            }
+        }
+#endif
+        return static_cast<std::size_t>(std::find(first, first + count, value) - first);
+    }
+
+    template <typename T>
+    std::size_t countEqual(const T* first, std::size_t count, const T& value)
+    {
+#if defined(__x86_64__) && defined(__GNUC__)
+        if constexpr (isSimdComparable<T>) {
+            if (hasAvx2()) {
+                return countAvx2(first, count, value);
+            }
+        }
+#endif
+        return static_cast<std::size_t>(std::count(first, first + count, value));
+    }
+
+    template <typename T>
+    std::ranges::minmax_result<T> minMax(const T* first, std::size_t count)
+    {
+#if defined(__x86_64__) && defined(__GNUC__)
+        if constexpr (isSimdOrdered<T>) {
+            if (hasAvx2()) {
+                return minMaxAvx2(first, count);
+            }
+        }
+#endif
+        return std::ranges::minmax(std::ranges::subrange(first, first + count));
+    }
+}
+
+/*
+* Sorts vector in ascending order. Integral and floating point elements are
+* radix sorted when vector holds at least radixSortThreshold of them, NaNs are
+* then placed before negative or after positive infinity depending on their sign
+* and -0.0 before 0.0. Other elements and short vectors use std::sort.
+*/
+template <typename T, typename Allocator, typename Stats>
+void sort(vector<T, Allocator, Stats>& vec)
+{
+    if constexpr (detail::isRadixSortable<T>) {
+        if (vec.size() >= detail::radixSortThreshold) {
+            detail::radixSort(vec);
+            return;
+        }
+    }
+    std::sort(vec.begin(), vec.end());
+}
+
+template <typename T, typename Allocator, typename Stats, typename U, typename Compare = std::less<>>
+typename vector<T, Allocator, Stats>::iterator lower_bound(vector<T, Allocator, Stats>& vec, const U& value, Compare comp = {})
+{
+    return vec.begin() + detail::lowerBoundIndex(vec.data(), vec.size(), value, comp);
+}
+
+template <typename T, typename Allocator, typename Stats, typename U, typename Compare = std::less<>>
+typename vector<T, Allocator, Stats>::const_iterator lower_bound(const vector<T, Allocator, Stats>& vec, const U& value, Compare comp = {})
+{
+    return vec.begin() + detail::lowerBoundIndex(vec.data(), vec.size(), value, comp);
+}
+
+template <typename T, typename Allocator, typename Stats>
+typename vector<T, Allocator, Stats>::iterator find(vector<T, Allocator, Stats>& vec, const T& value)
+{
+    return vec.begin() + detail::findIndex(vec.data(), vec.size(), value);
+}
+
+template <typename T, typename Allocator, typename Stats>
+typename vector<T, Allocator, Stats>::const_iterator find(const vector<T, Allocator, Stats>& vec, const T& value)
+{
+    return vec.begin() + detail::findIndex(vec.data(), vec.size(), value);
+}
+
+template <typename T, typename Allocator, typename Stats>
+typename vector<T, Allocator, Stats>::size_type count(const vector<T, Allocator, Stats>& vec, const T& value)
+{
+    return detail::countEqual(vec.data(), vec.size(), value);
+}
+
+// Like std::ranges::minmax, vector must not be empty.
+template <typename T, typename Allocator, typename Stats>
+std::ranges::minmax_result<T> min_max(const vector<T, Allocator, Stats>& vec)
+{
+    return detail::minMax(vec.data(), vec.size());
+}
+}
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include <new>
 #include <type_traits>
 
@@ -14,6 +15,10 @@ struct allocator {
 
     constexpr allocator() noexcept = default;
     constexpr allocator(const allocator& other) noexcept = default;
+    template <typename U>
+    constexpr allocator(const allocator<U>&) noexcept
+    {
+    }
     constexpr ~allocator() = default;
 
     [[nodiscard]] constexpr T* allocate(size_type n);
@@ -23,12 +28,22 @@ struct allocator {
 template <typename T>
 [[nodiscard]] constexpr T* allocator<T>::allocate(size_type n)
 {
+    // Constant evaluation forbids ::operator new with static_cast, std::allocator is allowed there.
+    if (std::is_constant_evaluated()) {
+        return std::allocator<T> {}.allocate(n);
+    }
     return static_cast<T*>(::operator new(n * sizeof(T)));
 }
 
 template <typename T>
 constexpr void allocator<T>::deallocate(T* p, [[maybe_unused]] size_type n)
 {
+    if (std::is_constant_evaluated()) {
+        if (p != nullptr) {
+            std::allocator<T> {}.deallocate(p, n);
+        }
+        return;
+    }
     ::operator delete(p);
 }
 }
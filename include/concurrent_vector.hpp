@@ -0,0 +1,270 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "allocator.hpp"
+
+namespace my_vec {
+/*
+* Append-only vector which allows many threads to push_back/emplace_back
+* concurrently without locks. Storage is split into geometrically growing
+* segments (segment k holds firstSegmentSize << k elements), so growth never
+* moves elements and references/indices handed out stay valid.
+*
+* push_back/emplace_back return index of the new element. An element may be
+* read by any thread once the index was passed to it (e.g. through a queue or
+* after joining the producer); size() only tells how many slots were claimed.
+* Every segment carries bitmap of slots whose construction finished, so when
+* allocation or construction of an element throws, its claimed slot simply stays
+* unmarked: the exception propagates, at() rejects the slot and destructor skips it.
+*/
+
+template <typename T, typename Allocator = my_alloc::allocator<T>>
+class concurrent_vector {
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+
+    constexpr static size_type firstSegmentSize = 8;
+
+    concurrent_vector() noexcept(noexcept(Allocator()));
+    explicit concurrent_vector(const Allocator& alloc);
+    concurrent_vector(const concurrent_vector&) = delete;
+    concurrent_vector& operator=(const concurrent_vector&) = delete;
+    ~concurrent_vector() noexcept;
+
+    reference at(size_type pos);
+    const_reference at(size_type pos) const;
+    reference operator[](size_type pos);
+    const_reference operator[](size_type pos) const;
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    size_type size() const noexcept { return size_.load(std::memory_order_acquire); }
+    size_type capacity() const noexcept;
+
+    size_type push_back(const T& value);
+    size_type push_back(T&& value);
+    template <typename... Args>
+    size_type emplace_back(Args&&... args);
+
+private:
+    constexpr static size_type firstSegmentBits_ = std::countr_zero(firstSegmentSize);
+    constexpr static size_type maxSegments_ = 8 * sizeof(size_type) - firstSegmentBits_;
+    constexpr static size_type bitsPerWord_ = 64;
+
+    using mask_word = std::atomic<std::uint64_t>;
+    using mask_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<mask_word>;
+
+    Allocator alloc_;
+    mask_allocator maskAlloc_;
+    std::array<std::atomic<T*>, maxSegments_> segments_ {};
+    // Bitmaps of constructed slots, published before segment they describe.
+    std::array<std::atomic<mask_word*>, maxSegments_> constructed_ {};
+    std::atomic<size_type> size_ { 0 };
+
+    constexpr static size_type getSegmentIndex(size_type pos) noexcept;
+    constexpr static size_type getSegmentSize(size_type segment) noexcept;
+    constexpr static size_type getSegmentBegin(size_type segment) noexcept;
+    constexpr static size_type getMaskWords(size_type segment) noexcept;
+    T* getOrAllocateSegment(size_type segment);
+    mask_word* getOrAllocateMask(size_type segment);
+    T* getSlot(size_type pos) const noexcept;
+    bool isConstructed(size_type pos) const noexcept;
+};
+
+template <typename T, typename Allocator>
+concurrent_vector<T, Allocator>::concurrent_vector() noexcept(noexcept(Allocator()))
+    : alloc_ { Allocator() }
+    , maskAlloc_ { alloc_ }
+{
+}
+
+template <typename T, typename Allocator>
+concurrent_vector<T, Allocator>::concurrent_vector(const Allocator& alloc)
+    : alloc_ { alloc }
+    , maskAlloc_ { alloc_ }
+{
+}
+
+template <typename T, typename Allocator>
+concurrent_vector<T, Allocator>::~concurrent_vector() noexcept
+{
+    for (size_type segment = 0; segment < maxSegments_; ++segment) {
+        // Mask may exist without segment when allocation of the segment threw.
+        mask_word* mask = constructed_[segment].load(std::memory_order_acquire);
+        if (mask == nullptr) {
+            continue;
+        }
+        T* elem = segments_[segment].load(std::memory_order_acquire);
+        for (size_type word = 0; word < getMaskWords(segment); ++word) {
+            for (auto bits = mask[word].load(std::memory_order_acquire); bits != 0; bits &= bits - 1) {
+                std::destroy_at(elem + word * bitsPerWord_ + static_cast<size_type>(std::countr_zero(bits)));
+            }
+        }
+        if (elem != nullptr) {
+            alloc_.deallocate(elem, getSegmentSize(segment));
+        }
+        maskAlloc_.deallocate(mask, getMaskWords(segment));
+    }
+}
+
+template <typename T, typename Allocator>
+typename concurrent_vector<T, Allocator>::reference concurrent_vector<T, Allocator>::at(size_type pos)
+{
+    if (pos >= size() || !isConstructed(pos)) {
+        throw std::out_of_range { "Position not within range of concurrent_vector" };
+    }
+    return *getSlot(pos);
+}
+
+template <typename T, typename Allocator>
+typename concurrent_vector<T, Allocator>::const_reference concurrent_vector<T, Allocator>::at(size_type pos) const
+{
+    if (pos >= size() || !isConstructed(pos)) {
+        throw std::out_of_range { "Position not within range of concurrent_vector" };
+    }
+    return *getSlot(pos);
+}
+
+template <typename T, typename Allocator>
+typename concurrent_vector<T, Allocator>::reference concurrent_vector<T, Allocator>::operator[](size_type pos)
+{
+    return *getSlot(pos);
+}
+
+template <typename T, typename Allocator>
+typename concurrent_vector<T, Allocator>::const_reference concurrent_vector<T, Allocator>::operator[](size_type pos) const
+{
+    return *getSlot(pos);
+}
+
+template <typename T, typename Allocator>
+typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::capacity() const noexcept
+{
+    // Producers may allocate later segment before earlier one, so there can be gaps.
+    size_type result = 0;
+    for (size_type segment = 0; segment < maxSegments_; ++segment) {
+        if (segments_[segment].load(std::memory_order_acquire) != nullptr) {
+            result += getSegmentSize(segment);
+        }
+    }
+    return result;
+}
+
+template <typename T, typename Allocator>
+typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::push_back(const T& value)
+{
+    return emplace_back(value);
+}
+
+template <typename T, typename Allocator>
+typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::push_back(T&& value)
+{
+    return emplace_back(std::move(value));
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::emplace_back(Args&&... args)
+{
+    const auto pos = size_.fetch_add(1, std::memory_order_acq_rel);
+    const auto segment = getSegmentIndex(pos);
+    const auto offset = pos - getSegmentBegin(segment);
+    // Slot cannot be given back to other producers, if anything below throws it stays unmarked.
+    T* elem = getOrAllocateSegment(segment);
+    std::construct_at(elem + offset, std::forward<Args>(args)...);
+    const auto bit = std::uint64_t { 1 } << (offset % bitsPerWord_);
+    constructed_[segment].load(std::memory_order_acquire)[offset / bitsPerWord_].fetch_or(bit, std::memory_order_release);
+    return pos;
+}
+
+template <typename T, typename Allocator>
+constexpr typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::getSegmentIndex(size_type pos) noexcept
+{
+    return static_cast<size_type>(std::bit_width(pos + firstSegmentSize)) - firstSegmentBits_ - 1;
+}
+
+template <typename T, typename Allocator>
+constexpr typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::getSegmentSize(size_type segment) noexcept
+{
+    return firstSegmentSize << segment;
+}
+
+template <typename T, typename Allocator>
+constexpr typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::getSegmentBegin(size_type segment) noexcept
+{
+    return getSegmentSize(segment) - firstSegmentSize;
+}
+
+template <typename T, typename Allocator>
+constexpr typename concurrent_vector<T, Allocator>::size_type concurrent_vector<T, Allocator>::getMaskWords(size_type segment) noexcept
+{
+    return (getSegmentSize(segment) + bitsPerWord_ - 1) / bitsPerWord_;
+}
+
+template <typename T, typename Allocator>
+T* concurrent_vector<T, Allocator>::getOrAllocateSegment(size_type segment)
+{
+    T* elem = segments_[segment].load(std::memory_order_acquire);
+    if (elem != nullptr) {
+        return elem;
+    }
+
+    getOrAllocateMask(segment);
+    // Several producers may race for the same segment, the loser gives its memory back.
+    T* allocated = alloc_.allocate(getSegmentSize(segment));
+    if (segments_[segment].compare_exchange_strong(elem, allocated, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return allocated;
+    }
+    alloc_.deallocate(allocated, getSegmentSize(segment));
+    return elem;
+}
+
+template <typename T, typename Allocator>
+typename concurrent_vector<T, Allocator>::mask_word* concurrent_vector<T, Allocator>::getOrAllocateMask(size_type segment)
+{
+    mask_word* mask = constructed_[segment].load(std::memory_order_acquire);
+    if (mask != nullptr) {
+        return mask;
+    }
+
+    const auto words = getMaskWords(segment);
+    mask_word* allocated = maskAlloc_.allocate(words);
+    for (size_type word = 0; word < words; ++word) {
+        std::construct_at(allocated + word, 0);
+    }
+    if (constructed_[segment].compare_exchange_strong(mask, allocated, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        return allocated;
+    }
+    maskAlloc_.deallocate(allocated, words);
+    return mask;
+}
+
+template <typename T, typename Allocator>
+T* concurrent_vector<T, Allocator>::getSlot(size_type pos) const noexcept
+{
+    const auto segment = getSegmentIndex(pos);
+    return segments_[segment].load(std::memory_order_acquire) + (pos - getSegmentBegin(segment));
+}
+
+template <typename T, typename Allocator>
+bool concurrent_vector<T, Allocator>::isConstructed(size_type pos) const noexcept
+{
+    const auto segment = getSegmentIndex(pos);
+    const mask_word* mask = constructed_[segment].load(std::memory_order_acquire);
+    if (mask == nullptr) {
+        return false;
+    }
+    const auto offset = pos - getSegmentBegin(segment);
+    return (mask[offset / bitsPerWord_].load(std::memory_order_acquire) >> (offset % bitsPerWord_) & 1) != 0;
+}
+}
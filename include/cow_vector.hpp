@@ -0,0 +1,279 @@
+#pragma once
+
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.hpp"
+
+namespace my_vec {
+/*
+* Copy-on-write vector. Copies share one reference-counted buffer, so copying
+* is O(1) and does not allocate; the first mutating operation on a copy whose
+* buffer is shared makes it private (unshare()). Reference count is atomic,
+* hence distinct cow_vectors sharing a buffer may be used from different
+* threads like distinct shared_ptrs.
+*
+* Non-const element access (operator[], at, front, back, data, begin, end)
+* counts as mutation. References and iterators obtained through it are
+* invalidated by the next unsharing and are not protected from copies made
+* after they were obtained: write through them before copying the vector.
+* Empty and moved-from cow_vectors hold no buffer at all.
+*/
+
+template <typename T, typename Allocator = my_alloc::allocator<T>>
+class cow_vector {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using vector_type = vector<T, Allocator>;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    cow_vector() noexcept(noexcept(Allocator())) = default;
+    explicit cow_vector(const Allocator& alloc) noexcept;
+    explicit cow_vector(vector_type values);
+    cow_vector(size_type count, const T& value, const Allocator& alloc = Allocator());
+    cow_vector(std::initializer_list<T> init, const Allocator& alloc = Allocator());
+    template <std::input_iterator InputIt>
+    cow_vector(InputIt first, InputIt last, const Allocator& alloc = Allocator());
+    cow_vector(const cow_vector& other) noexcept;
+    cow_vector& operator=(const cow_vector& other) noexcept;
+    cow_vector(cow_vector&& other) noexcept;
+    cow_vector& operator=(cow_vector&& other) noexcept;
+    ~cow_vector() noexcept { release(); }
+
+    allocator_type get_allocator() const noexcept { return alloc_; }
+    // Number of cow_vectors sharing the buffer, 0 when there is no buffer.
+    size_type use_count() const noexcept { return buffer_ == nullptr ? 0 : buffer_->refs.load(std::memory_order_acquire); }
+    void unshare();
+    const vector_type& values() const noexcept { return buffer_ == nullptr ? getEmptyValues() : buffer_->values; }
+
+    reference at(size_type pos);
+    const_reference at(size_type pos) const;
+    reference operator[](size_type pos) { return getUniqueValues()[pos]; }
+    const_reference operator[](size_type pos) const { return values()[pos]; }
+    reference front() { return getUniqueValues().front(); }
+    const_reference front() const { return values().front(); }
+    reference back() { return getUniqueValues().back(); }
+    const_reference back() const { return values().back(); }
+    T* data() { return getUniqueValues().data(); }
+    const T* data() const noexcept { return values().data(); }
+
+    iterator begin() { return getUniqueValues().begin(); }
+    const_iterator begin() const noexcept { return values().begin(); }
+    iterator end() { return getUniqueValues().end(); }
+    const_iterator end() const noexcept { return values().end(); }
+
+    [[nodiscard]] bool empty() const noexcept { return values().empty(); }
+    size_type size() const noexcept { return values().size(); }
+    size_type capacity() const noexcept { return values().capacity(); }
+    void reserve(size_type new_cap) { getUniqueValues().reserve(new_cap); }
+
+    // Drops reference to shared buffer instead of copying it.
+    void clear() noexcept;
+    iterator insert(const_iterator pos, const T& value);
+    iterator insert(const_iterator pos, T&& value);
+    iterator erase(const_iterator pos);
+    void push_back(const T& value) { getUniqueValues().push_back(value); }
+    void push_back(T&& value) { getUniqueValues().push_back(std::move(value)); }
+    template <typename... Args>
+    reference emplace_back(Args&&... args) { return getUniqueValues().emplace_back(std::forward<Args>(args)...); }
+    void pop_back() { getUniqueValues().pop_back(); }
+    void resize(size_type count) { getUniqueValues().resize(count); }
+    void resize(size_type count, const T& value) { getUniqueValues().resize(count, value); }
+    void swap(cow_vector& other) noexcept;
+
+private:
+    struct buffer {
+        std::atomic<size_type> refs;
+        vector_type values;
+    };
+
+    [[no_unique_address]] Allocator alloc_ {};
+    buffer* buffer_ = nullptr;
+
+    static const vector_type& getEmptyValues() noexcept;
+    vector_type& getUniqueValues();
+    size_type getIndex(const_iterator pos) const noexcept { return static_cast<size_type>(pos - values().begin()); }
+    void release() noexcept;
+};
+
+template <typename T, typename Allocator>
+cow_vector<T, Allocator>::cow_vector(const Allocator& alloc) noexcept
+    : alloc_ { alloc }
+{
+}
+
+template <typename T, typename Allocator>
+cow_vector<T, Allocator>::cow_vector(vector_type values)
+    : alloc_ { values.get_allocator() }
+    , buffer_ { new buffer { 1, std::move(values) } }
+{
+}
+
+template <typename T, typename Allocator>
+cow_vector<T, Allocator>::cow_vector(size_type count, const T& value, const Allocator& alloc)
+    : cow_vector(vector_type(count, value, alloc))
+{
+}
+
+template <typename T, typename Allocator>
+cow_vector<T, Allocator>::cow_vector(std::initializer_list<T> init, const Allocator& alloc)
+    : cow_vector(vector_type(init, alloc))
+{
+}
+
+template <typename T, typename Allocator>
+template <std::input_iterator InputIt>
+cow_vector<T, Allocator>::cow_vector(InputIt first, InputIt last, const Allocator& alloc)
+    : cow_vector(vector_type(first, last, alloc))
+{
+}
+
+template <typename T, typename Allocator>
+cow_vector<T, Allocator>::cow_vector(const cow_vector& other) noexcept
+    : alloc_ { other.alloc_ }
+    , buffer_ { other.buffer_ }
+{
+    if (buffer_ != nullptr) {
+        buffer_->refs.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+template <typename T, typename Allocator>
+cow_vector<T, Allocator>& cow_vector<T, Allocator>::operator=(const cow_vector& other) noexcept
+{
+    cow_vector copy { other };
+    swap(copy);
+    return *this;
+}
+
+template <typename T, typename Allocator>
+cow_vector<T, Allocator>::cow_vector(cow_vector&& other) noexcept
+    : alloc_ { other.alloc_ }
+    , buffer_ { std::exchange(other.buffer_, nullptr) }
+{
+}
+
+template <typename T, typename Allocator>
+cow_vector<T, Allocator>& cow_vector<T, Allocator>::operator=(cow_vector&& other) noexcept
+{
+    cow_vector moved { std::move(other) };
+    swap(moved);
+    return *this;
+}
+
+template <typename T, typename Allocator>
+void cow_vector<T, Allocator>::unshare()
+{
+    getUniqueValues();
+}
+
+template <typename T, typename Allocator>
+typename cow_vector<T, Allocator>::reference cow_vector<T, Allocator>::at(size_type pos)
+{
+    if (pos >= size()) {
+        throw std::out_of_range { "Position not within range of cow_vector" };
+    }
+    return getUniqueValues()[pos];
+}
+
+template <typename T, typename Allocator>
+typename cow_vector<T, Allocator>::const_reference cow_vector<T, Allocator>::at(size_type pos) const
+{
+    if (pos >= size()) {
+        throw std::out_of_range { "Position not within range of cow_vector" };
+    }
+    return values()[pos];
+}
+
+template <typename T, typename Allocator>
+void cow_vector<T, Allocator>::clear() noexcept
+{
+    if (use_count() == 1) {
+        buffer_->values.clear();
+    } else {
+        release();
+    }
+}
+
+template <typename T, typename Allocator>
+typename cow_vector<T, Allocator>::iterator cow_vector<T, Allocator>::insert(const_iterator pos, const T& value)
+{
+    const auto index = getIndex(pos);
+    auto& values = getUniqueValues();
+    return values.insert(values.begin() + index, value);
+}
+
+template <typename T, typename Allocator>
+typename cow_vector<T, Allocator>::iterator cow_vector<T, Allocator>::insert(const_iterator pos, T&& value)
+{
+    const auto index = getIndex(pos);
+    auto& values = getUniqueValues();
+    return values.insert(values.begin() + index, std::move(value));
+}
+
+template <typename T, typename Allocator>
+typename cow_vector<T, Allocator>::iterator cow_vector<T, Allocator>::erase(const_iterator pos)
+{
+    const auto index = getIndex(pos);
+    auto& values = getUniqueValues();
+    return values.erase(values.begin() + index);
+}
+
+template <typename T, typename Allocator>
+void cow_vector<T, Allocator>::swap(cow_vector& other) noexcept
+{
+    std::swap(alloc_, other.alloc_);
+    std::swap(buffer_, other.buffer_);
+}
+
+template <typename T, typename Allocator>
+const typename cow_vector<T, Allocator>::vector_type& cow_vector<T, Allocator>::getEmptyValues() noexcept
+{
+    static const vector_type empty;
+    return empty;
+}
+
+template <typename T, typename Allocator>
+typename cow_vector<T, Allocator>::vector_type& cow_vector<T, Allocator>::getUniqueValues()
+{
+    if (buffer_ == nullptr) {
+        buffer_ = new buffer { 1, vector_type(alloc_) };
+    } else if (buffer_->refs.load(std::memory_order_acquire) != 1) {
+        auto* copy = new buffer { 1, buffer_->values };
+        release();
+        buffer_ = copy;
+    }
+    return buffer_->values;
+}
+
+template <typename T, typename Allocator>
+void cow_vector<T, Allocator>::release() noexcept
+{
+    if (buffer_ != nullptr && buffer_->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete buffer_;
+    }
+    buffer_ = nullptr;
+}
+
+template <typename T, typename Allocator>
+bool operator==(const cow_vector<T, Allocator>& lhs, const cow_vector<T, Allocator>& rhs)
+{
+    return lhs.values() == rhs.values();
+}
+
+template <typename T, typename Allocator>
+auto operator<=>(const cow_vector<T, Allocator>& lhs, const cow_vector<T, Allocator>& rhs)
+{
+    return lhs.values() <=> rhs.values();
+}
+}
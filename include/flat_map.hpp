@@ -0,0 +1,475 @@
+#pragma once
+
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <numeric>
+#include <ranges>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "flat_set.hpp"
+#include "vector.hpp"
+
+namespace my_vec {
+/*
+* Sorted map over contiguous storage. Keys and mapped values live in two
+* separate vectors kept in the same order, so searches scan only densely packed
+* keys and values are touched only for found entries. Like flat_set, bulk
+* construction sorts once and insert_range merges sorted batch with stored
+* entries in one pass. Iterators pair key and value references on the fly.
+*/
+
+namespace detail {
+    template <typename KeyIt, typename MappedIt>
+    class flat_map_iterator {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::pair<std::iter_value_t<KeyIt>, std::iter_value_t<MappedIt>>;
+        using reference = std::pair<std::iter_reference_t<KeyIt>, std::iter_reference_t<MappedIt>>;
+        using difference_type = std::ptrdiff_t;
+
+        struct pointer {
+            reference ref;
+            const reference* operator->() const noexcept { return &ref; }
+        };
+
+        flat_map_iterator() = default;
+        flat_map_iterator(KeyIt key, MappedIt mapped)
+            : key_ { key }
+            , mapped_ { mapped }
+        {
+        }
+        template <typename OtherMappedIt>
+            requires std::convertible_to<OtherMappedIt, MappedIt>
+        flat_map_iterator(const flat_map_iterator<KeyIt, OtherMappedIt>& other)
+            : key_ { other.key_iterator() }
+            , mapped_ { other.mapped_iterator() }
+        {
+        }
+
+        KeyIt key_iterator() const noexcept { return key_; }
+        MappedIt mapped_iterator() const noexcept { return mapped_; }
+
+        reference operator*() const { return { *key_, *mapped_ }; }
+        pointer operator->() const { return { **this }; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        flat_map_iterator& operator++()
+        {
+            ++key_;
+            ++mapped_;
+            return *this;
+        }
+        flat_map_iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+        flat_map_iterator& operator--()
+        {
+            --key_;
+            --mapped_;
+            return *this;
+        }
+        flat_map_iterator operator--(int)
+        {
+            auto copy = *this;
+            --*this;
+            return copy;
+        }
+        flat_map_iterator& operator+=(difference_type n)
+        {
+            key_ += n;
+            mapped_ += n;
+            return *this;
+        }
+        flat_map_iterator& operator-=(difference_type n) { return *this += -n; }
+
+        friend flat_map_iterator operator+(flat_map_iterator it, difference_type n) { return it += n; }
+        friend flat_map_iterator operator+(difference_type n, flat_map_iterator it) { return it += n; }
+        friend flat_map_iterator operator-(flat_map_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const flat_map_iterator& lhs, const flat_map_iterator& rhs) { return lhs.key_ - rhs.key_; }
+        friend bool operator==(const flat_map_iterator& lhs, const flat_map_iterator& rhs) { return lhs.key_ == rhs.key_; }
+        friend auto operator<=>(const flat_map_iterator& lhs, const flat_map_iterator& rhs) { return lhs.key_ <=> rhs.key_; }
+
+    private:
+        KeyIt key_ {};
+        MappedIt mapped_ {};
+    };
+
+    // Sorts keys together with their values and keeps only first inserted of equivalent keys.
+    template <typename KeyContainer, typename MappedContainer, typename Compare>
+    void sortUniqueByKey(KeyContainer& keys, MappedContainer& values, Compare& comp)
+    {
+        vector<std::size_t> order(keys.size());
+        std::iota(order.begin(), order.end(), std::size_t { 0 });
+        std::sort(order.begin(), order.end(), [&keys, &comp](std::size_t lhs, std::size_t rhs) {
+            return comp(keys[lhs], keys[rhs]) || (!comp(keys[rhs], keys[lhs]) && lhs < rhs);
+        });
+
+        KeyContainer sortedKeys(keys.get_allocator());
+        MappedContainer sortedValues(values.get_allocator());
+        sortedKeys.reserve(keys.size());
+        sortedValues.reserve(values.size());
+        for (const auto index : order) {
+            if (!sortedKeys.empty() && !comp(sortedKeys.back(), keys[index])) {
+                continue;
+            }
+            sortedKeys.push_back(std::move(keys[index]));
+            sortedValues.push_back(std::move(values[index]));
+        }
+        keys = std::move(sortedKeys);
+        values = std::move(sortedValues);
+    }
+
+    // Merges sorted unique incoming entries into sorted unique stored ones, stored entry wins over equivalent incoming one.
+    template <typename KeyContainer, typename MappedContainer, typename Compare>
+    void mergeUniqueByKey(KeyContainer& keys, MappedContainer& values, KeyContainer& incomingKeys, MappedContainer& incomingValues, Compare& comp)
+    {
+        if (incomingKeys.empty()) {
+            return;
+        }
+        if (keys.empty() || comp(keys.back(), incomingKeys.front())) {
+            keys.insert(keys.end(), std::make_move_iterator(incomingKeys.begin()), std::make_move_iterator(incomingKeys.end()));
+            values.insert(values.end(), std::make_move_iterator(incomingValues.begin()), std::make_move_iterator(incomingValues.end()));
+            return;
+        }
+
+        KeyContainer mergedKeys(keys.get_allocator());
+        MappedContainer mergedValues(values.get_allocator());
+        mergedKeys.reserve(keys.size() + incomingKeys.size());
+        mergedValues.reserve(values.size() + incomingValues.size());
+        std::size_t stored = 0;
+        std::size_t added = 0;
+        while (stored < keys.size() && added < incomingKeys.size()) {
+            if (comp(incomingKeys[added], keys[stored])) {
+                mergedKeys.push_back(std::move(incomingKeys[added]));
+                mergedValues.push_back(std::move(incomingValues[added]));
+                ++added;
+            } else {
+                if (!comp(keys[stored], incomingKeys[added])) {
+                    ++added;
+                }
+                mergedKeys.push_back(std::move(keys[stored]));
+                mergedValues.push_back(std::move(values[stored]));
+                ++stored;
+            }
+        }
+        for (; stored < keys.size(); ++stored) {
+            mergedKeys.push_back(std::move(keys[stored]));
+            mergedValues.push_back(std::move(values[stored]));
+        }
+        for (; added < incomingKeys.size(); ++added) {
+            mergedKeys.push_back(std::move(incomingKeys[added]));
+            mergedValues.push_back(std::move(incomingValues[added]));
+        }
+        keys = std::move(mergedKeys);
+        values = std::move(mergedValues);
+    }
+}
+
+template <typename Key, typename T, typename Compare = std::less<Key>, typename KeyContainer = vector<Key>, typename MappedContainer = vector<T>>
+class flat_map {
+public:
+    using key_type = Key;
+    using mapped_type = T;
+    using value_type = std::pair<Key, T>;
+    using key_compare = Compare;
+    using key_container_type = KeyContainer;
+    using mapped_container_type = MappedContainer;
+    using size_type = std::size_t;
+    using iterator = detail::flat_map_iterator<typename KeyContainer::const_iterator, typename MappedContainer::iterator>;
+    using const_iterator = detail::flat_map_iterator<typename KeyContainer::const_iterator, typename MappedContainer::const_iterator>;
+
+    struct containers {
+        key_container_type keys;
+        mapped_container_type values;
+    };
+
+    flat_map() = default;
+    explicit flat_map(const Compare& comp);
+    flat_map(key_container_type keys, mapped_container_type values, const Compare& comp = Compare());
+    flat_map(sorted_unique_t, key_container_type keys, mapped_container_type values, const Compare& comp = Compare());
+    template <std::input_iterator InputIt>
+    flat_map(InputIt first, InputIt last, const Compare& comp = Compare());
+    flat_map(std::initializer_list<value_type> ilist, const Compare& comp = Compare());
+
+    iterator begin() noexcept { return { std::as_const(keys_).begin(), values_.begin() }; }
+    const_iterator begin() const noexcept { return { keys_.begin(), values_.begin() }; }
+    iterator end() noexcept { return { std::as_const(keys_).end(), values_.end() }; }
+    const_iterator end() const noexcept { return { keys_.end(), values_.end() }; }
+
+    [[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+    size_type size() const noexcept { return keys_.size(); }
+    key_compare key_comp() const { return comp_; }
+    const key_container_type& keys() const noexcept { return keys_; }
+    const mapped_container_type& values() const noexcept { return values_; }
+
+    T& operator[](const Key& key) { return try_emplace(key).first->second; }
+    T& operator[](Key&& key) { return try_emplace(std::move(key)).first->second; }
+    T& at(const Key& key);
+    const T& at(const Key& key) const;
+
+    std::pair<iterator, bool> insert(const value_type& value) { return try_emplace(value.first, value.second); }
+    std::pair<iterator, bool> insert(value_type&& value) { return try_emplace(std::move(value.first), std::move(value.second)); }
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args);
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(Key&& key, Args&&... args);
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, M&& obj);
+    template <std::ranges::input_range R>
+    void insert_range(R&& rg);
+    iterator erase(const_iterator pos);
+    size_type erase(const Key& key);
+    void clear() noexcept;
+    void swap(flat_map& other) noexcept;
+
+    containers extract() &&;
+    void replace(key_container_type&& keys, mapped_container_type&& values);
+
+    iterator find(const Key& key) { return toIterator(findIndex(key)); }
+    const_iterator find(const Key& key) const { return toIterator(findIndex(key)); }
+    bool contains(const Key& key) const { return findIndex(key) != size(); }
+    size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+    iterator lower_bound(const Key& key) { return toIterator(lowerBoundIndex(key)); }
+    const_iterator lower_bound(const Key& key) const { return toIterator(lowerBoundIndex(key)); }
+    iterator upper_bound(const Key& key) { return toIterator(upperBoundIndex(key)); }
+    const_iterator upper_bound(const Key& key) const { return toIterator(upperBoundIndex(key)); }
+
+    friend bool operator==(const flat_map& lhs, const flat_map& rhs) { return lhs.keys_ == rhs.keys_ && lhs.values_ == rhs.values_; }
+
+private:
+    [[no_unique_address]] Compare comp_ {};
+    KeyContainer keys_ {};
+    MappedContainer values_ {};
+
+    size_type lowerBoundIndex(const Key& key) const;
+    size_type upperBoundIndex(const Key& key) const;
+    size_type findIndex(const Key& key) const;
+    iterator toIterator(size_type index);
+    const_iterator toIterator(size_type index) const;
+    template <typename K, typename... Args>
+    std::pair<iterator, bool> tryEmplaceAt(size_type index, K&& key, Args&&... args);
+};
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::flat_map(const Compare& comp)
+    : comp_ { comp }
+{
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::flat_map(key_container_type keys, mapped_container_type values, const Compare& comp)
+    : comp_ { comp }
+    , keys_(std::move(keys))
+    , values_(std::move(values))
+{
+    if (keys_.size() != values_.size()) {
+        throw std::invalid_argument { "Keys and values of flat_map differ in size" };
+    }
+    detail::sortUniqueByKey(keys_, values_, comp_);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::flat_map(sorted_unique_t, key_container_type keys, mapped_container_type values, const Compare& comp)
+    : comp_ { comp }
+    , keys_(std::move(keys))
+    , values_(std::move(values))
+{
+    if (keys_.size() != values_.size()) {
+        throw std::invalid_argument { "Keys and values of flat_map differ in size" };
+    }
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+template <std::input_iterator InputIt>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::flat_map(InputIt first, InputIt last, const Compare& comp)
+    : comp_ { comp }
+{
+    insert_range(std::ranges::subrange(first, last));
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::flat_map(std::initializer_list<value_type> ilist, const Compare& comp)
+    : flat_map(ilist.begin(), ilist.end(), comp)
+{
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+T& flat_map<Key, T, Compare, KeyContainer, MappedContainer>::at(const Key& key)
+{
+    const auto index = findIndex(key);
+    if (index == size()) {
+        throw std::out_of_range { "Key not present in flat_map" };
+    }
+    return values_[index];
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+const T& flat_map<Key, T, Compare, KeyContainer, MappedContainer>::at(const Key& key) const
+{
+    const auto index = findIndex(key);
+    if (index == size()) {
+        throw std::out_of_range { "Key not present in flat_map" };
+    }
+    return values_[index];
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+template <typename... Args>
+std::pair<typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator, bool>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::try_emplace(const Key& key, Args&&... args)
+{
+    return tryEmplaceAt(lowerBoundIndex(key), key, std::forward<Args>(args)...);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+template <typename... Args>
+std::pair<typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator, bool>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::try_emplace(Key&& key, Args&&... args)
+{
+    return tryEmplaceAt(lowerBoundIndex(key), std::move(key), std::forward<Args>(args)...);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+template <typename M>
+std::pair<typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator, bool>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::insert_or_assign(const Key& key, M&& obj)
+{
+    auto result = try_emplace(key, std::forward<M>(obj));
+    if (!result.second) {
+        result.first->second = std::forward<M>(obj);
+    }
+    return result;
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+template <std::ranges::input_range R>
+void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::insert_range(R&& rg)
+{
+    key_container_type incomingKeys(keys_.get_allocator());
+    mapped_container_type incomingValues(values_.get_allocator());
+    if constexpr (std::ranges::sized_range<R>) {
+        incomingKeys.reserve(static_cast<size_type>(std::ranges::size(rg)));
+        incomingValues.reserve(static_cast<size_type>(std::ranges::size(rg)));
+    }
+    for (auto&& entry : rg) {
+        incomingKeys.push_back(std::forward<decltype(entry)>(entry).first);
+        incomingValues.push_back(std::forward<decltype(entry)>(entry).second);
+    }
+    detail::sortUniqueByKey(incomingKeys, incomingValues, comp_);
+    detail::mergeUniqueByKey(keys_, values_, incomingKeys, incomingValues, comp_);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator flat_map<Key, T, Compare, KeyContainer, MappedContainer>::erase(const_iterator pos)
+{
+    const auto index = static_cast<size_type>(pos - begin());
+    keys_.erase(keys_.begin() + static_cast<std::ptrdiff_t>(index));
+    values_.erase(values_.begin() + static_cast<std::ptrdiff_t>(index));
+    return toIterator(index);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type flat_map<Key, T, Compare, KeyContainer, MappedContainer>::erase(const Key& key)
+{
+    const auto index = findIndex(key);
+    if (index == size()) {
+        return 0;
+    }
+    erase(toIterator(index));
+    return 1;
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::clear() noexcept
+{
+    keys_.clear();
+    values_.clear();
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::swap(flat_map& other) noexcept
+{
+    std::swap(comp_, other.comp_);
+    keys_.swap(other.keys_);
+    values_.swap(other.values_);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::containers flat_map<Key, T, Compare, KeyContainer, MappedContainer>::extract() &&
+{
+    containers result { std::move(keys_), std::move(values_) };
+    clear();
+    return result;
+}
+
+// Keys have to be sorted and unique with respect to key_comp() and match values in size.
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+void flat_map<Key, T, Compare, KeyContainer, MappedContainer>::replace(key_container_type&& keys, mapped_container_type&& values)
+{
+    if (keys.size() != values.size()) {
+        throw std::invalid_argument { "Keys and values of flat_map differ in size" };
+    }
+    keys_ = std::move(keys);
+    values_ = std::move(values);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type flat_map<Key, T, Compare, KeyContainer, MappedContainer>::lowerBoundIndex(const Key& key) const
+{
+    return static_cast<size_type>(std::lower_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type flat_map<Key, T, Compare, KeyContainer, MappedContainer>::upperBoundIndex(const Key& key) const
+{
+    return static_cast<size_type>(std::upper_bound(keys_.begin(), keys_.end(), key, comp_) - keys_.begin());
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::size_type flat_map<Key, T, Compare, KeyContainer, MappedContainer>::findIndex(const Key& key) const
+{
+    const auto index = lowerBoundIndex(key);
+    return index != size() && !comp_(key, keys_[index]) ? index : size();
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator flat_map<Key, T, Compare, KeyContainer, MappedContainer>::toIterator(size_type index)
+{
+    return begin() + static_cast<std::ptrdiff_t>(index);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::const_iterator flat_map<Key, T, Compare, KeyContainer, MappedContainer>::toIterator(size_type index) const
+{
+    return begin() + static_cast<std::ptrdiff_t>(index);
+}
+
+template <typename Key, typename T, typename Compare, typename KeyContainer, typename MappedContainer>
+template <typename K, typename... Args>
+std::pair<typename flat_map<Key, T, Compare, KeyContainer, MappedContainer>::iterator, bool>
+flat_map<Key, T, Compare, KeyContainer, MappedContainer>::tryEmplaceAt(size_type index, K&& key, Args&&... args)
+{
+    if (index != size() && !comp_(key, keys_[index])) {
+        return { toIterator(index), false };
+    }
+    const auto offset = static_cast<std::ptrdiff_t>(index);
+    keys_.insert(keys_.begin() + offset, std::forward<K>(key));
+    try {
+        values_.emplace(values_.begin() + offset, std::forward<Args>(args)...);
+    } catch (...) {
+        keys_.erase(keys_.begin() + offset);
+        throw;
+    }
+    return { toIterator(index), true };
+}
+}
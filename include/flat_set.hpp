@@ -0,0 +1,372 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <ranges>
+#include <utility>
+
+#include "vector.hpp"
+
+namespace my_vec {
+/*
+* Sorted set over contiguous storage. Keys are kept unique and sorted in one
+* vector, so lookups are binary searches over contiguous memory. Constructing
+* from unsorted keys sorts and deduplicates them once, insert_range sorts only
+* incoming keys and merges them with stored ones in a single pass instead of
+* shifting the tail for every key.
+* eytzinger_set holds the same keys in breadth-first order of an implicit
+* binary search tree: first levels of every search share few cache lines,
+* descending needs no branches and descendants four levels down are prefetched.
+* It is built once from keys and then only searched.
+*/
+
+struct sorted_unique_t {
+    explicit sorted_unique_t() = default;
+};
+inline constexpr sorted_unique_t sorted_unique {};
+
+namespace detail {
+    // Sorts keys and keeps only one of every group of equivalent ones.
+    template <typename Container, typename Compare>
+    void sortUnique(Container& keys, Compare& comp)
+    {
+        std::sort(keys.begin(), keys.end(), comp);
+        keys.erase(std::unique(keys.begin(), keys.end(), [&comp](const auto& lhs, const auto& rhs) { return !comp(lhs, rhs); }), keys.end());
+    }
+
+    // Merges sorted unique incoming keys into sorted unique keys, stored key wins over equivalent incoming one.
+    template <typename Container, typename Compare>
+    void mergeUnique(Container& keys, Container& incoming, Compare& comp)
+    {
+        if (incoming.empty()) {
+            return;
+        }
+        if (keys.empty() || comp(keys.back(), incoming.front())) {
+            keys.insert(keys.end(), std::make_move_iterator(incoming.begin()), std::make_move_iterator(incoming.end()));
+            return;
+        }
+
+        Container merged(keys.get_allocator());
+        merged.reserve(keys.size() + incoming.size());
+        auto stored = keys.begin();
+        auto added = incoming.begin();
+        while (stored != keys.end() && added != incoming.end()) {
+            if (comp(*added, *stored)) {
+                merged.push_back(std::move(*added++));
+            } else {
+                if (!comp(*stored, *added)) {
+                    ++added;
+                }
+                merged.push_back(std::move(*stored++));
+            }
+        }
+        merged.insert(merged.end(), std::make_move_iterator(stored), std::make_move_iterator(keys.end()));
+        merged.insert(merged.end(), std::make_move_iterator(added), std::make_move_iterator(incoming.end()));
+        keys = std::move(merged);
+    }
+
+    // Writes to order[node] index of sorted key which in-order traversal of implicit tree visits at node.
+    template <typename Order>
+    void eytzingerOrder(Order& order, std::size_t node, std::size_t& next)
+    {
+        if (node >= order.size()) {
+            return;
+        }
+        eytzingerOrder(order, 2 * node + 1, next);
+        order[node] = next++;
+        eytzingerOrder(order, 2 * node + 2, next);
+    }
+}
+
+template <typename Key, typename Compare = std::less<Key>, typename KeyContainer = vector<Key>>
+class flat_set {
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using value_compare = Compare;
+    using container_type = KeyContainer;
+    using size_type = typename KeyContainer::size_type;
+    using reference = const Key&;
+    using const_reference = const Key&;
+    using iterator = typename KeyContainer::const_iterator;
+    using const_iterator = typename KeyContainer::const_iterator;
+
+    flat_set() = default;
+    explicit flat_set(const Compare& comp);
+    explicit flat_set(container_type keys, const Compare& comp = Compare());
+    flat_set(sorted_unique_t, container_type keys, const Compare& comp = Compare());
+    template <std::input_iterator InputIt>
+    flat_set(InputIt first, InputIt last, const Compare& comp = Compare());
+    flat_set(std::initializer_list<Key> ilist, const Compare& comp = Compare());
+
+    const_iterator begin() const noexcept { return keys_.begin(); }
+    const_iterator end() const noexcept { return keys_.end(); }
+
+    [[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+    size_type size() const noexcept { return keys_.size(); }
+    key_compare key_comp() const { return comp_; }
+
+    std::pair<iterator, bool> insert(const Key& key);
+    std::pair<iterator, bool> insert(Key&& key);
+    template <std::ranges::input_range R>
+    void insert_range(R&& rg);
+    iterator erase(const_iterator pos);
+    size_type erase(const Key& key);
+    void clear() noexcept { keys_.clear(); }
+    void swap(flat_set& other) noexcept;
+
+    container_type extract() &&;
+    void replace(container_type&& keys);
+
+    iterator find(const Key& key) const;
+    bool contains(const Key& key) const { return find(key) != end(); }
+    size_type count(const Key& key) const { return contains(key) ? 1 : 0; }
+    iterator lower_bound(const Key& key) const;
+    iterator upper_bound(const Key& key) const;
+    std::pair<iterator, iterator> equal_range(const Key& key) const;
+
+    friend bool operator==(const flat_set& lhs, const flat_set& rhs) { return lhs.keys_ == rhs.keys_; }
+
+private:
+    [[no_unique_address]] Compare comp_ {};
+    KeyContainer keys_ {};
+
+    template <typename K>
+    std::pair<iterator, bool> insertUnique(K&& key);
+};
+
+template <typename Key, typename Compare = std::less<Key>, typename KeyContainer = vector<Key>>
+class eytzinger_set {
+public:
+    using key_type = Key;
+    using value_type = Key;
+    using key_compare = Compare;
+    using container_type = KeyContainer;
+    using size_type = typename KeyContainer::size_type;
+    using iterator = typename KeyContainer::const_iterator;
+    using const_iterator = typename KeyContainer::const_iterator;
+
+    eytzinger_set() = default;
+    explicit eytzinger_set(container_type keys, const Compare& comp = Compare());
+    explicit eytzinger_set(const flat_set<Key, Compare, KeyContainer>& set);
+
+    // Iteration visits keys in breadth-first order of search tree, not in sorted order.
+    const_iterator begin() const noexcept { return keys_.begin(); }
+    const_iterator end() const noexcept { return keys_.end(); }
+
+    [[nodiscard]] bool empty() const noexcept { return keys_.empty(); }
+    size_type size() const noexcept { return keys_.size(); }
+    key_compare key_comp() const { return comp_; }
+
+    iterator find(const Key& key) const;
+    bool contains(const Key& key) const { return find(key) != end(); }
+    // Smallest key not less than given one, end() if there is none.
+    iterator lower_bound(const Key& key) const { return begin() + static_cast<std::ptrdiff_t>(lowerBoundIndex(key)); }
+
+private:
+    [[no_unique_address]] Compare comp_ {};
+    KeyContainer keys_ {};
+
+    void buildFromSorted(container_type&& sorted);
+    size_type lowerBoundIndex(const Key& key) const;
+};
+
+template <typename Key, typename Compare, typename KeyContainer>
+flat_set<Key, Compare, KeyContainer>::flat_set(const Compare& comp)
+    : comp_ { comp }
+{
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+flat_set<Key, Compare, KeyContainer>::flat_set(container_type keys, const Compare& comp)
+    : comp_ { comp }
+    , keys_(std::move(keys))
+{
+    detail::sortUnique(keys_, comp_);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+flat_set<Key, Compare, KeyContainer>::flat_set(sorted_unique_t, container_type keys, const Compare& comp)
+    : comp_ { comp }
+    , keys_(std::move(keys))
+{
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+template <std::input_iterator InputIt>
+flat_set<Key, Compare, KeyContainer>::flat_set(InputIt first, InputIt last, const Compare& comp)
+    : flat_set(container_type(first, last), comp)
+{
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+flat_set<Key, Compare, KeyContainer>::flat_set(std::initializer_list<Key> ilist, const Compare& comp)
+    : flat_set(container_type(ilist), comp)
+{
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+std::pair<typename flat_set<Key, Compare, KeyContainer>::iterator, bool> flat_set<Key, Compare, KeyContainer>::insert(const Key& key)
+{
+    return insertUnique(key);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+std::pair<typename flat_set<Key, Compare, KeyContainer>::iterator, bool> flat_set<Key, Compare, KeyContainer>::insert(Key&& key)
+{
+    return insertUnique(std::move(key));
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+template <std::ranges::input_range R>
+void flat_set<Key, Compare, KeyContainer>::insert_range(R&& rg)
+{
+    container_type incoming(keys_.get_allocator());
+    if constexpr (std::ranges::sized_range<R>) {
+        incoming.reserve(static_cast<size_type>(std::ranges::size(rg)));
+    }
+    for (auto&& key : rg) {
+        incoming.push_back(std::forward<decltype(key)>(key));
+    }
+    detail::sortUnique(incoming, comp_);
+    detail::mergeUnique(keys_, incoming, comp_);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+typename flat_set<Key, Compare, KeyContainer>::iterator flat_set<Key, Compare, KeyContainer>::erase(const_iterator pos)
+{
+    return keys_.erase(pos);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+typename flat_set<Key, Compare, KeyContainer>::size_type flat_set<Key, Compare, KeyContainer>::erase(const Key& key)
+{
+    const auto it = find(key);
+    if (it == end()) {
+        return 0;
+    }
+    keys_.erase(it);
+    return 1;
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+void flat_set<Key, Compare, KeyContainer>::swap(flat_set& other) noexcept
+{
+    std::swap(comp_, other.comp_);
+    keys_.swap(other.keys_);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+typename flat_set<Key, Compare, KeyContainer>::container_type flat_set<Key, Compare, KeyContainer>::extract() &&
+{
+    auto keys = std::move(keys_);
+    keys_.clear();
+    return keys;
+}
+
+// Keys have to be sorted and unique with respect to key_comp().
+template <typename Key, typename Compare, typename KeyContainer>
+void flat_set<Key, Compare, KeyContainer>::replace(container_type&& keys)
+{
+    keys_ = std::move(keys);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+typename flat_set<Key, Compare, KeyContainer>::iterator flat_set<Key, Compare, KeyContainer>::find(const Key& key) const
+{
+    const auto it = lower_bound(key);
+    return it != end() && !comp_(key, *it) ? it : end();
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+typename flat_set<Key, Compare, KeyContainer>::iterator flat_set<Key, Compare, KeyContainer>::lower_bound(const Key& key) const
+{
+    return std::lower_bound(keys_.begin(), keys_.end(), key, comp_);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+typename flat_set<Key, Compare, KeyContainer>::iterator flat_set<Key, Compare, KeyContainer>::upper_bound(const Key& key) const
+{
+    return std::upper_bound(keys_.begin(), keys_.end(), key, comp_);
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+std::pair<typename flat_set<Key, Compare, KeyContainer>::iterator, typename flat_set<Key, Compare, KeyContainer>::iterator>
+flat_set<Key, Compare, KeyContainer>::equal_range(const Key& key) const
+{
+    const auto it = find(key);
+    return { it, it == end() ? it : std::next(it) };
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+template <typename K>
+std::pair<typename flat_set<Key, Compare, KeyContainer>::iterator, bool> flat_set<Key, Compare, KeyContainer>::insertUnique(K&& key)
+{
+    const auto it = lower_bound(key);
+    if (it != end() && !comp_(key, *it)) {
+        return { it, false };
+    }
+    return { keys_.insert(it, std::forward<K>(key)), true };
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+eytzinger_set<Key, Compare, KeyContainer>::eytzinger_set(container_type keys, const Compare& comp)
+    : comp_ { comp }
+    , keys_(keys.get_allocator())
+{
+    detail::sortUnique(keys, comp_);
+    buildFromSorted(std::move(keys));
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+eytzinger_set<Key, Compare, KeyContainer>::eytzinger_set(const flat_set<Key, Compare, KeyContainer>& set)
+    : comp_ { set.key_comp() }
+{
+    buildFromSorted(container_type(set.begin(), set.end()));
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+typename eytzinger_set<Key, Compare, KeyContainer>::iterator eytzinger_set<Key, Compare, KeyContainer>::find(const Key& key) const
+{
+    const auto it = lower_bound(key);
+    return it != end() && !comp_(key, *it) ? it : end();
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+void eytzinger_set<Key, Compare, KeyContainer>::buildFromSorted(container_type&& sorted)
+{
+    vector<std::size_t> order(sorted.size());
+    std::size_t next = 0;
+    detail::eytzingerOrder(order, 0, next);
+
+    keys_.clear();
+    keys_.reserve(sorted.size());
+    for (const auto index : order) {
+        keys_.push_back(std::move(sorted[index]));
+    }
+}
+
+template <typename Key, typename Compare, typename KeyContainer>
+typename eytzinger_set<Key, Compare, KeyContainer>::size_type eytzinger_set<Key, Compare, KeyContainer>::lowerBoundIndex(const Key& key) const
+{
+    const auto count = keys_.size();
+    const Key* base = keys_.data();
+    std::size_t node = 0;
+    while (node < count) {
+#if defined(__GNUC__)
+        // Sixteen descendants four levels below node are adjacent, one prefetch covers most of them.
+        __builtin_prefetch(base + std::min(16 * node + 15, count - 1));
+#endif
+        node = 2 * node + 1 + (comp_(base[node], key) ? 1 : 0);
+    }
+    // Path went right on every comparison after last left turn, which happened at the lower bound.
+    auto position = node + 1;
+    position >>= std::countr_one(position) + 1;
+    return position == 0 ? count : position - 1;
+}
+}
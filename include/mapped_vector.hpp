@@ -0,0 +1,374 @@
+#pragma once
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstring>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace my_vec {
+/*
+* Vector of trivially copyable elements stored directly in a file mapping.
+* File contains raw elements only, so opening existing file costs nothing
+* regardless of its size and data written by one process is visible to others.
+* - read_write: file is created if needed, storage grows by ftruncate and remapping,
+*   sync() and destruction truncate file to size() elements, so file reopened after
+*   crash never shows spare capacity as elements; after sync() the spare capacity is
+*   given back to file lazily, on next growth of size()
+* - read_only: file is mapped read only, modifiers throw std::logic_error
+* - copy_on_write: file is mapped privately, changes are never written back
+*/
+
+enum class map_mode {
+    read_write,
+    read_only,
+    copy_on_write
+};
+
+template <typename T>
+class mapped_vector {
+    static_assert(std::is_trivially_copyable_v<T>, "mapped_vector requires trivially copyable elements");
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using pointer = T*;
+    using const_pointer = const T*;
+    using iterator = T*;
+    using const_iterator = const T*;
+    using reverse_iterator = std::reverse_iterator<iterator>;
+    using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+    using difference_type = std::ptrdiff_t;
+
+    explicit mapped_vector(const std::string& path, map_mode mode = map_mode::read_write);
+    mapped_vector(const mapped_vector&) = delete;
+    mapped_vector& operator=(const mapped_vector&) = delete;
+    mapped_vector(mapped_vector&& other) noexcept;
+    mapped_vector& operator=(mapped_vector&& other) noexcept;
+    ~mapped_vector() noexcept;
+
+    reference at(size_type pos);
+    const_reference at(size_type pos) const;
+    reference operator[](size_type pos) { return elem_[pos]; }
+    const_reference operator[](size_type pos) const { return elem_[pos]; }
+    reference front() { return elem_[0]; }
+    const_reference front() const { return elem_[0]; }
+    reference back() { return elem_[size_ - 1]; }
+    const_reference back() const { return elem_[size_ - 1]; }
+    T* data() noexcept { return elem_; }
+    const T* data() const noexcept { return elem_; }
+
+    iterator begin() noexcept { return elem_; }
+    const_iterator begin() const noexcept { return elem_; }
+    iterator end() noexcept { return elem_ + size_; }
+    const_iterator end() const noexcept { return elem_ + size_; }
+
+    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    size_type size() const noexcept { return size_; }
+    void reserve(size_type new_cap);
+    size_type capacity() const noexcept { return space_; }
+    map_mode mode() const noexcept { return mode_; }
+
+    void clear();
+    void push_back(const T& value);
+    template <typename... Args>
+    reference emplace_back(Args&&... args);
+    void pop_back();
+    void resize(size_type count, const T& value = T());
+    void sync();
+
+private:
+    int fd_;
+    map_mode mode_;
+    T* elem_;
+    size_type size_;
+    size_type space_;
+    // Elements file currently holds, below space_ only after sync() truncated it.
+    size_type fileSpace_;
+
+    void remap(size_type new_cap);
+    void restoreFileSpace();
+    void release() noexcept;
+    void throwIfReadOnly() const;
+    size_type getGrowCapacity() const noexcept;
+    [[noreturn]] static void throwSystemError(const char* what);
+};
+
+template <typename T>
+mapped_vector<T>::mapped_vector(const std::string& path, map_mode mode)
+    : fd_ { -1 }
+    , mode_ { mode }
+    , elem_ { nullptr }
+    , size_ { 0 }
+    , space_ { 0 }
+    , fileSpace_ { 0 }
+{
+    fd_ = mode_ == map_mode::read_write ? ::open(path.c_str(), O_RDWR | O_CREAT, 0644) : ::open(path.c_str(), O_RDONLY);
+    if (fd_ < 0) {
+        throwSystemError("Cannot open file for mapped_vector");
+    }
+
+    struct stat fileStat { };
+    if (::fstat(fd_, &fileStat) != 0) {
+        const auto error = errno;
+        ::close(fd_);
+        throw std::system_error { error, std::generic_category(), "Cannot read size of file for mapped_vector" };
+    }
+    const auto fileSize = static_cast<size_type>(fileStat.st_size);
+    if (fileSize % sizeof(T) != 0) {
+        ::close(fd_);
+        throw std::runtime_error { "File size is not a multiple of mapped_vector element size" };
+    }
+
+    const auto count = fileSize / sizeof(T);
+    if (count != 0) {
+        const int protection = mode_ == map_mode::read_only ? PROT_READ : PROT_READ | PROT_WRITE;
+        const int flags = mode_ == map_mode::read_write ? MAP_SHARED : MAP_PRIVATE;
+        void* mapping = ::mmap(nullptr, fileSize, protection, flags, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            const auto error = errno;
+            ::close(fd_);
+            throw std::system_error { error, std::generic_category(), "Cannot map file for mapped_vector" };
+        }
+        elem_ = static_cast<T*>(mapping);
+    }
+    size_ = count;
+    space_ = count;
+    fileSpace_ = count;
+}
+
+template <typename T>
+mapped_vector<T>::mapped_vector(mapped_vector&& other) noexcept
+    : fd_ { other.fd_ }
+    , mode_ { other.mode_ }
+    , elem_ { other.elem_ }
+    , size_ { other.size_ }
+    , space_ { other.space_ }
+    , fileSpace_ { other.fileSpace_ }
+{
+    other.fd_ = -1;
+    other.elem_ = nullptr;
+    other.size_ = 0;
+    other.space_ = 0;
+    other.fileSpace_ = 0;
+}
+
+template <typename T>
+mapped_vector<T>& mapped_vector<T>::operator=(mapped_vector&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        fd_ = std::exchange(other.fd_, -1);
+        mode_ = other.mode_;
+        elem_ = std::exchange(other.elem_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        space_ = std::exchange(other.space_, 0);
+        fileSpace_ = std::exchange(other.fileSpace_, 0);
+    }
+    return *this;
+}
+
+template <typename T>
+mapped_vector<T>::~mapped_vector() noexcept
+{
+    release();
+}
+
+template <typename T>
+typename mapped_vector<T>::reference mapped_vector<T>::at(size_type pos)
+{
+    if (pos >= size()) {
+        throw std::out_of_range { "Position not within range of mapped_vector" };
+    }
+    return elem_[pos];
+}
+
+template <typename T>
+typename mapped_vector<T>::const_reference mapped_vector<T>::at(size_type pos) const
+{
+    if (pos >= size()) {
+        throw std::out_of_range { "Position not within range of mapped_vector" };
+    }
+    return elem_[pos];
+}
+
+template <typename T>
+void mapped_vector<T>::reserve(size_type new_cap)
+{
+    throwIfReadOnly();
+    if (new_cap > capacity()) {
+        remap(new_cap);
+    }
+}
+
+template <typename T>
+void mapped_vector<T>::clear()
+{
+    throwIfReadOnly();
+    size_ = 0;
+}
+
+template <typename T>
+void mapped_vector<T>::push_back(const T& value)
+{
+    emplace_back(value);
+}
+
+template <typename T>
+template <typename... Args>
+typename mapped_vector<T>::reference mapped_vector<T>::emplace_back(Args&&... args)
+{
+    throwIfReadOnly();
+    // Arguments may refer to element of this vector, so value is built before remap() unmaps it.
+    const T value(std::forward<Args>(args)...);
+    if (size() >= capacity()) {
+        remap(getGrowCapacity());
+    } else if (size() >= fileSpace_) {
+        restoreFileSpace();
+    }
+    std::construct_at(&elem_[size_], value);
+    return elem_[size_++];
+}
+
+template <typename T>
+void mapped_vector<T>::pop_back()
+{
+    throwIfReadOnly();
+    --size_;
+}
+
+template <typename T>
+void mapped_vector<T>::resize(size_type count, const T& value)
+{
+    // Value may refer to element of this vector, so it is copied before reserve() unmaps it.
+    const T copy = value;
+    reserve(count);
+    if (count > size()) {
+        if (count > fileSpace_) {
+            restoreFileSpace();
+        }
+        std::uninitialized_fill(elem_ + size_, elem_ + count, copy);
+    }
+    size_ = count;
+}
+
+template <typename T>
+void mapped_vector<T>::sync()
+{
+    if (mode_ != map_mode::read_write) {
+        return;
+    }
+    if (size_ != 0 && ::msync(elem_, size_ * sizeof(T), MS_SYNC) != 0) {
+        throwSystemError("Cannot synchronize mapped_vector with file");
+    }
+    // Mapping keeps its length, pages past end of file are not touched until restoreFileSpace().
+    if (fileSpace_ != size_) {
+        if (::ftruncate(fd_, static_cast<off_t>(size_ * sizeof(T))) != 0 || ::fsync(fd_) != 0) {
+            throwSystemError("Cannot truncate file of mapped_vector");
+        }
+        fileSpace_ = size_;
+    }
+}
+
+template <typename T>
+void mapped_vector<T>::remap(size_type new_cap)
+{
+    const auto newBytes = new_cap * sizeof(T);
+    if (mode_ == map_mode::read_write) {
+        if (::ftruncate(fd_, static_cast<off_t>(newBytes)) != 0) {
+            throwSystemError("Cannot grow file of mapped_vector");
+        }
+        void* mapping = ::mmap(nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd_, 0);
+        if (mapping == MAP_FAILED) {
+            throwSystemError("Cannot map file for mapped_vector");
+        }
+        if (elem_ != nullptr) {
+            ::munmap(elem_, space_ * sizeof(T));
+        }
+        elem_ = static_cast<T*>(mapping);
+        fileSpace_ = new_cap;
+    } else {
+        // Private mapping cannot extend past end of file, so grown copy lives in anonymous memory.
+        void* mapping = ::mmap(nullptr, newBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (mapping == MAP_FAILED) {
+            throwSystemError("Cannot map memory for mapped_vector");
+        }
+        if (elem_ != nullptr) {
+            std::memcpy(mapping, elem_, size_ * sizeof(T));
+            ::munmap(elem_, space_ * sizeof(T));
+        }
+        elem_ = static_cast<T*>(mapping);
+    }
+    space_ = new_cap;
+}
+
+template <typename T>
+void mapped_vector<T>::restoreFileSpace()
+{
+    if (mode_ == map_mode::read_write) {
+        if (::ftruncate(fd_, static_cast<off_t>(space_ * sizeof(T))) != 0) {
+            throwSystemError("Cannot grow file of mapped_vector");
+        }
+        fileSpace_ = space_;
+    }
+}
+
+template <typename T>
+void mapped_vector<T>::release() noexcept
+{
+    if (elem_ != nullptr) {
+        ::munmap(elem_, space_ * sizeof(T));
+    }
+    if (fd_ >= 0) {
+        if (mode_ == map_mode::read_write) {
+            // Nothing sensible can be done about failure in destructor, file keeps spare capacity then.
+            [[maybe_unused]] const auto result = ::ftruncate(fd_, static_cast<off_t>(size_ * sizeof(T)));
+        }
+        ::close(fd_);
+    }
+    fd_ = -1;
+    elem_ = nullptr;
+    size_ = 0;
+    space_ = 0;
+    fileSpace_ = 0;
+}
+
+template <typename T>
+void mapped_vector<T>::throwIfReadOnly() const
+{
+    if (mode_ == map_mode::read_only) {
+        throw std::logic_error { "mapped_vector opened in read only mode" };
+    }
+}
+
+template <typename T>
+typename mapped_vector<T>::size_type mapped_vector<T>::getGrowCapacity() const noexcept
+{
+    const auto elementsPerPage = std::max<size_type>(1, static_cast<size_type>(::sysconf(_SC_PAGESIZE)) / sizeof(T));
+    return std::max(2 * capacity(), elementsPerPage);
+}
+
+template <typename T>
+void mapped_vector<T>::throwSystemError(const char* what)
+{
+    throw std::system_error { errno, std::generic_category(), what };
+}
+}
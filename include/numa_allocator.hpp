@@ -0,0 +1,194 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <limits>
+#include <new>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace my_alloc {
+/*
+* Allocator which controls NUMA placement of large blocks.
+* - local: pages are populated during allocation (MAP_POPULATE), so they land on node of allocating thread
+* - interleave: pages are spread round-robin over all online nodes (mbind MPOL_INTERLEAVE)
+* - first_touch: fresh pages are returned untouched and without reserved swap (MAP_NORESERVE), so
+*   partitioned construction (e.g. my_vec::parallel::make_vector) places every slice on node of
+*   worker which initializes it
+* Blocks smaller than mappingThreshold and platforms without mmap/mbind use ::operator new.
+*/
+
+enum class numa_policy {
+    local,
+    interleave,
+    first_touch
+};
+
+template <typename T>
+struct numa_allocator {
+    using value_type = T;
+    using size_type = std::size_t;
+
+    constexpr static size_type mappingThreshold = 1 << 16;
+
+    constexpr numa_allocator() noexcept = default;
+    constexpr explicit numa_allocator(numa_policy policy) noexcept
+        : policy_ { policy }
+    {
+    }
+    constexpr numa_allocator(const numa_allocator& other) noexcept = default;
+    template <typename U>
+    constexpr numa_allocator(const numa_allocator<U>& other) noexcept
+        : policy_ { other.policy() }
+    {
+    }
+    constexpr numa_allocator& operator=(const numa_allocator& other) noexcept = default;
+    constexpr ~numa_allocator() = default;
+
+    [[nodiscard]] T* allocate(size_type n);
+    void deallocate(T* p, size_type n);
+
+    constexpr numa_policy policy() const noexcept { return policy_; }
+
+    static bool numa_available() noexcept;
+
+private:
+    numa_policy policy_ { numa_policy::local };
+
+    static bool shouldMap(size_type bytes) noexcept { return bytes >= mappingThreshold; }
+    static int getMappingFlags(numa_policy policy) noexcept;
+    static void interleave(void* p, size_type bytes) noexcept;
+    static unsigned long getOnlineNodesMask() noexcept;
+};
+
+template <typename T>
+constexpr bool operator==(const numa_allocator<T>& lhs, const numa_allocator<T>& rhs) noexcept
+{
+    return lhs.policy() == rhs.policy();
+}
+
+template <typename T>
+[[nodiscard]] T* numa_allocator<T>::allocate(size_type n)
+{
+    if (n > std::numeric_limits<size_type>::max() / sizeof(T)) {
+        throw std::bad_array_new_length {};
+    }
+    const auto bytes = n * sizeof(T);
+#if defined(__linux__)
+    if (shouldMap(bytes)) {
+        void* p = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | getMappingFlags(policy_), -1, 0);
+        if (p == MAP_FAILED) {
+            throw std::bad_alloc {};
+        }
+        if (policy_ == numa_policy::interleave) {
+            interleave(p, bytes);
+        }
+        return static_cast<T*>(p);
+    }
+#endif
+    return static_cast<T*>(::operator new(bytes));
+}
+
+template <typename T>
+void numa_allocator<T>::deallocate(T* p, size_type n)
+{
+    if (p == nullptr) {
+        return;
+    }
+    const auto bytes = n * sizeof(T);
+#if defined(__linux__)
+    if (shouldMap(bytes)) {
+        ::munmap(p, bytes);
+        return;
+    }
+#endif
+    ::operator delete(p);
+}
+
+template <typename T>
+int numa_allocator<T>::getMappingFlags([[maybe_unused]] numa_policy policy) noexcept
+{
+#if defined(__linux__)
+    switch (policy) {
+    case numa_policy::local:
+        return MAP_POPULATE;
+    case numa_policy::first_touch:
+        return MAP_NORESERVE;
+    case numa_policy::interleave:
+        // Pages must stay untouched until mbind applies the policy.
+        return 0;
+    }
+#endif
+    return 0;
+}
+
+template <typename T>
+bool numa_allocator<T>::numa_available() noexcept
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    const auto mask = getOnlineNodesMask();
+    return mask != 0 && (mask & (mask - 1)) != 0;
+#else
+    return false;
+#endif
+}
+
+template <typename T>
+void numa_allocator<T>::interleave([[maybe_unused]] void* p, [[maybe_unused]] size_type bytes) noexcept
+{
+#if defined(__linux__) && defined(SYS_mbind)
+    // Value of MPOL_INTERLEAVE from <numaif.h>, syscall is used directly so no libnuma linkage is needed.
+    constexpr long mpolInterleave = 3;
+    const auto mask = getOnlineNodesMask();
+    if (mask == 0) {
+        return;
+    }
+    // Placement is only a hint, on failure pages simply follow default policy.
+    ::syscall(SYS_mbind, p, bytes, mpolInterleave, &mask, 8 * sizeof(mask), 0);
+#endif
+}
+
+template <typename T>
+unsigned long numa_allocator<T>::getOnlineNodesMask() noexcept
+{
+    static const unsigned long mask = [] {
+        // Format of the file is a list of ranges, e.g. "0-1,4".
+        std::ifstream online { "/sys/devices/system/node/online" };
+        std::string ranges;
+        if (!(online >> ranges)) {
+            return 0UL;
+        }
+
+        unsigned long result = 0;
+        std::size_t pos = 0;
+        try {
+            while (pos < ranges.size()) {
+                std::size_t parsed = 0;
+                const auto first = std::stoul(ranges.substr(pos), &parsed);
+                pos += parsed;
+                auto last = first;
+                if (pos < ranges.size() && ranges[pos] == '-') {
+                    last = std::stoul(ranges.substr(++pos), &parsed);
+                    pos += parsed;
+                }
+                for (auto node = first; node <= last && node < 8 * sizeof(result); ++node) {
+                    result |= 1UL << node;
+                }
+                if (pos < ranges.size() && ranges[pos] == ',') {
+                    ++pos;
+                }
+            }
+        } catch (...) {
+            return 0UL;
+        }
+        return result;
+    }();
+    return mask;
+}
+}
@@ -0,0 +1,434 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.hpp"
+#include "vector.hpp"
+
+namespace my_vec::parallel {
+/*
+* Parallel versions of vector bulk operations. Work is split into chunks
+* executed on a thread_pool, ranges shorter than pool's sequential threshold
+* stay on the calling thread. Every chunk touches only its own slice of
+* memory, so pages are first touched by the thread which processes them.
+* sort sorts one run per chunk and merges pairs of runs in rounds, ping-ponging
+* between vector and scratch buffer from vector's allocator. Every merge is split
+* at equal output offsets (merge path), so the last rounds, which merge few long
+* runs, still keep all threads busy.
+*/
+
+namespace detail {
+    // Runs constructFn(begin, end) over chunks of count raw elements starting at first. Constructing
+    // function has to clean up after itself, chunks which succeeded are destroyed if any other throws.
+    template <typename T, typename ConstructFn>
+    void uninitializedForEachChunk(thread_pool& pool, T* first, std::size_t count, ConstructFn&& constructFn)
+    {
+        std::mutex constructedMutex;
+        std::vector<std::pair<std::size_t, std::size_t>> constructed;
+        try {
+            pool.parallel_for(0, count, [&](std::size_t begin, std::size_t end) {
+                constructFn(begin, end);
+                std::lock_guard lock { constructedMutex };
+                constructed.emplace_back(begin, end);
+            });
+        } catch (...) {
+            for (const auto& [begin, end] : constructed) {
+                std::destroy(first + begin, first + end);
+            }
+            throw;
+        }
+    }
+
+    // Number of elements of a taken by merge of a and b into its first k outputs, elements of a win ties.
+    template <typename T, typename Compare>
+    std::size_t mergePathSplit(const T* a, std::size_t aSize, const T* b, std::size_t bSize, std::size_t k, Compare& comp)
+    {
+        auto low = k > bSize ? k - bSize : 0;
+        auto high = std::min(k, aSize);
+        while (low < high) {
+            const auto middle = low + (high - low) / 2;
+            if (comp(b[k - middle - 1], a[middle])) {
+                high = middle;
+            } else {
+                low = middle + 1;
+            }
+        }
+        return low;
+    }
+
+    // Moves merge of [a, aLast) and [b, bLast) to out, which is advanced past every placed element.
+    template <bool Construct, typename T, typename Compare>
+    void moveMerge(T* a, T* aLast, T* b, T* bLast, T*& out, Compare& comp)
+    {
+        auto place = [&out](T& value) {
+            if constexpr (Construct) {
+                std::construct_at(out, std::move(value));
+            } else {
+                *out = std::move(value);
+            }
+            ++out;
+        };
+        while (a != aLast && b != bLast) {
+            place(comp(*b, *a) ? *b++ : *a++);
+        }
+        for (; a != aLast; ++a) {
+            place(*a);
+        }
+        for (; b != bLast; ++b) {
+            place(*b);
+        }
+    }
+
+    // Index into runs of first run of pair which holds output position, runs holds start of every run
+    // followed by total size and pairs start at every other entry.
+    inline std::size_t pairContaining(const std::vector<std::size_t>& runs, std::size_t position)
+    {
+        return static_cast<std::size_t>(std::upper_bound(runs.begin(), runs.end() - 1, position) - runs.begin() - 1) & ~std::size_t { 1 };
+    }
+
+    struct merge_split {
+        std::size_t position;
+        // Elements of first run of pair containing position which precede it in merged output.
+        std::size_t taken;
+    };
+
+    // Splits output of merge round into equal segments. Splits are searched before any element is
+    // moved, as merge path of one segment reads elements which other segments move away.
+    template <typename T, typename Compare>
+    std::vector<merge_split> mergeSplits(const T* source, const std::vector<std::size_t>& runs, std::size_t numOfSegments, Compare& comp)
+    {
+        const auto count = runs.back();
+        std::vector<merge_split> splits;
+        splits.reserve(numOfSegments + 1);
+        for (std::size_t segment = 0; segment <= numOfSegments; ++segment) {
+            const auto position = segment * count / numOfSegments;
+            std::size_t taken = 0;
+            if (position < count) {
+                const auto pair = pairContaining(runs, position);
+                const auto first = runs[pair];
+                const auto middle = runs[pair + 1];
+                const auto last = pair + 2 < runs.size() ? runs[pair + 2] : middle;
+                taken = mergePathSplit(source + first, middle - first, source + middle, last - middle, position - first, comp);
+            }
+            splits.push_back({ position, taken });
+        }
+        return splits;
+    }
+
+    // Merges pairs of adjacent runs of source into dest between output positions of two splits,
+    // run without a pair is moved as is. out is advanced past every placed element.
+    template <bool Construct, typename T, typename Compare>
+    void mergeSegment(T* source, const std::vector<std::size_t>& runs, const merge_split& from, const merge_split& to, T*& out, Compare& comp)
+    {
+        for (auto pair = pairContaining(runs, from.position); pair + 1 < runs.size() && runs[pair] < to.position; pair += 2) {
+            const auto first = runs[pair];
+            const auto middle = runs[pair + 1];
+            const auto last = pair + 2 < runs.size() ? runs[pair + 2] : middle;
+            const auto outBegin = from.position > first ? from.position - first : 0;
+            const auto aBegin = from.position > first ? from.taken : 0;
+            const auto outEnd = std::min(to.position, last) - first;
+            const auto aEnd = to.position < last ? to.taken : middle - first;
+            moveMerge<Construct>(source + first + aBegin, source + first + aEnd,
+                source + middle + (outBegin - aBegin), source + middle + (outEnd - aEnd), out, comp);
+        }
+    }
+
+    // Runs one merge round from source to dest, segments are assigned to chunk which holds their start.
+    // Constructing round destroys everything it built if any segment throws.
+    template <bool Construct, typename T, typename Compare>
+    void mergeRound(thread_pool& pool, T* source, T* dest, const std::vector<std::size_t>& runs, Compare& comp)
+    {
+        const auto splits = mergeSplits(source, runs, 8 * (pool.size() + 1), comp);
+        std::mutex mergedMutex;
+        std::vector<std::size_t> merged;
+        try {
+            pool.parallel_for(0, runs.back(), [&](std::size_t begin, std::size_t end) {
+                auto segment = static_cast<std::size_t>(std::lower_bound(splits.begin(), splits.end(), begin, [](const auto& split, std::size_t position) {
+                    return split.position < position;
+                }) - splits.begin());
+                for (; segment + 1 < splits.size() && splits[segment].position < end; ++segment) {
+                    T* out = dest + splits[segment].position;
+                    try {
+                        mergeSegment<Construct>(source, runs, splits[segment], splits[segment + 1], out, comp);
+                    } catch (...) {
+                        if constexpr (Construct) {
+                            std::destroy(dest + splits[segment].position, out);
+                        }
+                        throw;
+                    }
+                    if constexpr (Construct) {
+                        std::lock_guard lock { mergedMutex };
+                        merged.push_back(segment);
+                    }
+                }
+            });
+        } catch (...) {
+            if constexpr (Construct) {
+                for (const auto segment : merged) {
+                    std::destroy(dest + splits[segment].position, dest + splits[segment + 1].position);
+                }
+            }
+            throw;
+        }
+    }
+
+    // Scans [first, last) in place starting from carry, returns carry for next element.
+    template <typename T, typename BinaryOp>
+    T inclusiveScanSequential(T* first, T* last, T carry, BinaryOp& op)
+    {
+        for (; first != last; ++first) {
+            carry = op(std::move(carry), *first);
+            *first = carry;
+        }
+        return carry;
+    }
+
+    template <typename T, typename BinaryOp>
+    T exclusiveScanSequential(T* first, T* last, T carry, BinaryOp& op)
+    {
+        for (; first != last; ++first) {
+            T next = op(carry, *first);
+            *first = std::move(carry);
+            carry = std::move(next);
+        }
+        return carry;
+    }
+
+    // Reduce-then-scan: chunk totals are reduced in parallel, folded on the calling thread into carry
+    // of every chunk and chunks are scanned in parallel from their carries. Only exclusive scan has
+    // carry before the first element, inclusive one starts from the first element itself.
+    template <bool Inclusive, typename T, typename BinaryOp>
+    void scan(thread_pool& pool, T* elem, std::size_t count, std::optional<T> init, BinaryOp& op)
+    {
+        auto scanRange = [&op](T* first, T* last, std::optional<T> carry) {
+            if constexpr (Inclusive) {
+                if (!carry) {
+                    carry = *first++;
+                }
+                inclusiveScanSequential(first, last, std::move(*carry), op);
+            } else {
+                exclusiveScanSequential(first, last, std::move(*carry), op);
+            }
+        };
+        if (count == 0) {
+            return;
+        }
+        if (count < pool.sequential_threshold() || pool.size() == 0) {
+            scanRange(elem, elem + count, std::move(init));
+            return;
+        }
+
+        std::mutex totalsMutex;
+        std::vector<std::pair<std::size_t, T>> totals;
+        pool.parallel_for(0, count, [&](std::size_t begin, std::size_t end) {
+            T total = elem[begin];
+            for (std::size_t i = begin + 1; i < end; ++i) {
+                total = op(std::move(total), elem[i]);
+            }
+            std::lock_guard lock { totalsMutex };
+            totals.emplace_back(begin, std::move(total));
+        });
+        std::sort(totals.begin(), totals.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+        std::vector<std::size_t> starts;
+        std::vector<std::optional<T>> carries;
+        starts.reserve(totals.size());
+        carries.reserve(totals.size());
+        for (auto& [begin, total] : totals) {
+            starts.push_back(begin);
+            carries.push_back(init);
+            init = init ? op(std::move(*init), std::move(total)) : std::move(total);
+        }
+
+        pool.parallel_for(0, count, [&](std::size_t begin, std::size_t end) {
+            // Chunks normally repeat those of reduction, otherwise carry is completed from start of enclosing chunk.
+            const auto chunk = static_cast<std::size_t>(std::upper_bound(starts.begin(), starts.end(), begin) - starts.begin() - 1);
+            auto carry = carries[chunk];
+            for (std::size_t i = starts[chunk]; i < begin; ++i) {
+                carry = carry ? op(std::move(*carry), elem[i]) : elem[i];
+            }
+            scanRange(elem + begin, elem + end, std::move(carry));
+        });
+    }
+}
+
+template <typename T, typename Allocator = my_alloc::allocator<T>>
+vector<T, Allocator> make_vector(std::size_t count, const T& value, const Allocator& alloc = Allocator(), thread_pool& pool = thread_pool::instance())
+{
+    vector<T, Allocator> vec(alloc);
+    vec.reserve(count);
+    T* elem = vec.data();
+    detail::uninitializedForEachChunk(pool, elem, count, [elem, &value](std::size_t begin, std::size_t end) {
+        std::uninitialized_fill(elem + begin, elem + end, value);
+    });
+    my_vec::detail::vector_access::setSize(vec, count);
+    return vec;
+}
+
+template <typename T, typename Allocator, typename Stats>
+vector<T, Allocator, Stats> copy(const vector<T, Allocator, Stats>& other, thread_pool& pool = thread_pool::instance())
+{
+    vector<T, Allocator, Stats> vec(other.get_allocator());
+    vec.reserve(other.size());
+    T* elem = vec.data();
+    const T* source = other.data();
+    detail::uninitializedForEachChunk(pool, elem, other.size(), [elem, source](std::size_t begin, std::size_t end) {
+        std::uninitialized_copy(source + begin, source + end, elem + begin);
+    });
+    my_vec::detail::vector_access::setSize(vec, other.size());
+    return vec;
+}
+
+template <typename T, typename Allocator, typename Stats>
+void fill(vector<T, Allocator, Stats>& vec, const T& value, thread_pool& pool = thread_pool::instance())
+{
+    T* elem = vec.data();
+    pool.parallel_for(0, vec.size(), [elem, &value](std::size_t begin, std::size_t end) {
+        std::fill(elem + begin, elem + end, value);
+    });
+}
+
+template <typename T, typename Allocator, typename Stats>
+void resize(vector<T, Allocator, Stats>& vec, std::size_t count, const T& value = T(), thread_pool& pool = thread_pool::instance())
+{
+    const auto oldSize = vec.size();
+    if (count <= oldSize) {
+        vec.resize(count);
+        return;
+    }
+
+    vec.reserve(count);
+    T* tail = vec.data() + oldSize;
+    detail::uninitializedForEachChunk(pool, tail, count - oldSize, [tail, &value](std::size_t begin, std::size_t end) {
+        std::uninitialized_fill(tail + begin, tail + end, value);
+    });
+    my_vec::detail::vector_access::setSize(vec, count);
+}
+
+template <typename T, typename Allocator, typename Stats, typename UnaryOp>
+auto transform(const vector<T, Allocator, Stats>& vec, UnaryOp op, thread_pool& pool = thread_pool::instance())
+{
+    using result_type = std::remove_cvref_t<std::invoke_result_t<UnaryOp&, const T&>>;
+    using result_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<result_type>;
+    vector<result_type, result_allocator> result { result_allocator(vec.get_allocator()) };
+    result.reserve(vec.size());
+    result_type* elem = result.data();
+    const T* source = vec.data();
+    detail::uninitializedForEachChunk(pool, elem, vec.size(), [elem, source, &op](std::size_t begin, std::size_t end) {
+        std::size_t i = begin;
+        try {
+            for (; i < end; ++i) {
+                std::construct_at(elem + i, std::invoke(op, source[i]));
+            }
+        } catch (...) {
+            std::destroy(elem + begin, elem + i);
+            throw;
+        }
+    });
+    my_vec::detail::vector_access::setSize(result, vec.size());
+    return result;
+}
+
+template <typename T, typename Allocator, typename Stats, typename U, typename BinaryOp = std::plus<>>
+U reduce(const vector<T, Allocator, Stats>& vec, U init, BinaryOp op = {}, thread_pool& pool = thread_pool::instance())
+{
+    std::mutex resultMutex;
+    std::vector<std::pair<std::size_t, U>> partials;
+    const T* source = vec.data();
+    pool.parallel_for(0, vec.size(), [&](std::size_t begin, std::size_t end) {
+        U partial = source[begin];
+        for (std::size_t i = begin + 1; i < end; ++i) {
+            partial = op(std::move(partial), source[i]);
+        }
+        std::lock_guard lock { resultMutex };
+        partials.emplace_back(begin, std::move(partial));
+    });
+
+    // Partial results are folded in range order, so op has to be associative but not commutative.
+    std::sort(partials.begin(), partials.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+    for (auto& [begin, partial] : partials) {
+        init = op(std::move(init), std::move(partial));
+    }
+    return init;
+}
+
+template <typename T, typename Allocator, typename Stats, typename Compare = std::less<>>
+void sort(vector<T, Allocator, Stats>& vec, Compare comp = {}, thread_pool& pool = thread_pool::instance())
+{
+    const auto count = vec.size();
+    T* elem = vec.data();
+    std::mutex runsMutex;
+    std::vector<std::size_t> runs;
+    pool.parallel_for(0, count, pool.size() + 1, [&](std::size_t begin, std::size_t end) {
+        std::sort(elem + begin, elem + end, comp);
+        std::lock_guard lock { runsMutex };
+        runs.push_back(begin);
+    });
+    if (runs.size() < 2) {
+        return;
+    }
+    std::sort(runs.begin(), runs.end());
+    runs.push_back(count);
+
+    auto alloc = vec.get_allocator();
+    T* scratch = alloc.allocate(count);
+    // First round move-constructs every element of scratch, later rounds move-assign between buffers.
+    try {
+        detail::mergeRound<true>(pool, elem, scratch, runs, comp);
+    } catch (...) {
+        alloc.deallocate(scratch, count);
+        throw;
+    }
+
+    T* source = scratch;
+    T* dest = elem;
+    try {
+        while (true) {
+            std::vector<std::size_t> merged;
+            for (std::size_t i = 0; i + 1 < runs.size(); i += 2) {
+                merged.push_back(runs[i]);
+            }
+            merged.push_back(count);
+            runs = std::move(merged);
+            if (runs.size() <= 2) {
+                break;
+            }
+            detail::mergeRound<false>(pool, source, dest, runs, comp);
+            std::swap(source, dest);
+        }
+        if (source != elem) {
+            pool.parallel_for(0, count, [&](std::size_t begin, std::size_t end) {
+                std::move(scratch + begin, scratch + end, elem + begin);
+            });
+        }
+    } catch (...) {
+        std::destroy(scratch, scratch + count);
+        alloc.deallocate(scratch, count);
+        throw;
+    }
+    std::destroy(scratch, scratch + count);
+    alloc.deallocate(scratch, count);
+}
+
+// Replaces every element with fold of op over elements up to and including it, op has to be associative.
+template <typename T, typename Allocator, typename Stats, typename BinaryOp = std::plus<>>
+void inclusive_scan(vector<T, Allocator, Stats>& vec, BinaryOp op = {}, thread_pool& pool = thread_pool::instance())
+{
+    detail::scan<true>(pool, vec.data(), vec.size(), std::optional<T> {}, op);
+}
+
+// Replaces every element with fold of op over init and elements before it, op has to be associative.
+template <typename T, typename Allocator, typename Stats, typename BinaryOp = std::plus<>>
+void exclusive_scan(vector<T, Allocator, Stats>& vec, T init, BinaryOp op = {}, thread_pool& pool = thread_pool::instance())
+{
+    detail::scan<false>(pool, vec.data(), vec.size(), std::optional<T> { std::move(init) }, op);
+}
+}
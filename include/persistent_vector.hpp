@@ -0,0 +1,629 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <compare>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.hpp"
+
+namespace my_vec {
+/*
+* Immutable vector with structural sharing, laid out as 32-way trie of leaves
+* holding 32 elements each plus separate tail leaf with the last (up to 32)
+* elements. Updates copy only the path from root to changed leaf, i.e.
+* O(log32 n) nodes, and share everything else with previous version, so
+* keeping many historical versions costs memory proportional to the changes.
+* push_back and pop_back usually touch only the tail.
+*
+* transient_vector is mutable companion for batches of changes: nodes it
+* created itself are updated in place and only nodes shared with persistent
+* versions are copied. Each transient owns unique token stamped on nodes it
+* creates; persistent() hands out current tree and switches to a new token,
+* which freezes everything handed out.
+*/
+
+template <typename T, typename Allocator>
+class persistent_vector;
+
+template <typename T, typename Allocator>
+class transient_vector;
+
+namespace detail {
+    inline std::uint64_t makeTransientOwner() noexcept
+    {
+        static std::atomic<std::uint64_t> nextOwner { 1 };
+        return nextOwner.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    template <typename T, typename Allocator>
+    struct persistent_tree {
+        using size_type = std::size_t;
+        using vector_type = vector<T, Allocator>;
+
+        constexpr static size_type bits = 5;
+        constexpr static size_type branching = size_type { 1 } << bits;
+        constexpr static size_type mask = branching - 1;
+
+        struct node {
+            std::uint64_t owner;
+        };
+        struct leaf : node {
+            leaf(std::uint64_t owner, const Allocator& alloc)
+                : node { owner }
+                , values(alloc)
+            {
+                values.reserve(branching);
+            }
+            leaf(std::uint64_t owner, const leaf& other)
+                : node { owner }
+                , values(other.values)
+            {
+            }
+            vector_type values;
+        };
+        struct branch : node {
+            std::array<std::shared_ptr<node>, branching> children {};
+        };
+
+        // Nodes come from Allocator too, so allocator sees whole trie and not only element buffers.
+        using leaf_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<leaf>;
+        using branch_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<branch>;
+
+        [[no_unique_address]] Allocator alloc {};
+        size_type size = 0;
+        // Distance in bits between root and leaves, i.e. bits per branch level times number of levels.
+        size_type shift = bits;
+        std::shared_ptr<node> root {};
+        std::shared_ptr<node> tail {};
+
+        static const leaf& toLeaf(const node& n) noexcept { return static_cast<const leaf&>(n); }
+        static leaf& toLeaf(node& n) noexcept { return static_cast<leaf&>(n); }
+        static const branch& toBranch(const node& n) noexcept { return static_cast<const branch&>(n); }
+        static branch& toBranch(node& n) noexcept { return static_cast<branch&>(n); }
+
+        size_type getTailOffset() const noexcept { return size == 0 ? 0 : ((size - 1) >> bits) << bits; }
+        const vector_type& getLeaf(size_type pos) const noexcept;
+        const std::shared_ptr<node>& getTreeLeaf(size_type pos) const noexcept;
+
+        template <typename U>
+        void pushBack(std::uint64_t owner, U&& value);
+        template <typename U>
+        void set(std::uint64_t owner, size_type pos, U&& value);
+        void popBack(std::uint64_t owner);
+
+        std::shared_ptr<node> editLeaf(std::uint64_t owner, const std::shared_ptr<node>& n) const;
+        std::shared_ptr<node> editBranch(std::uint64_t owner, const std::shared_ptr<node>& n) const;
+        void pushTail(std::uint64_t owner);
+        std::shared_ptr<node> insertTail(std::uint64_t owner, size_type level, const std::shared_ptr<node>& n) const;
+        template <typename U>
+        std::shared_ptr<node> setInTree(std::uint64_t owner, size_type level, const std::shared_ptr<node>& n, size_type pos, U&& value) const;
+        std::shared_ptr<node> removeLastLeaf(std::uint64_t owner, size_type level, const std::shared_ptr<node>& n) const;
+    };
+
+    template <typename T, typename Allocator>
+    const typename persistent_tree<T, Allocator>::vector_type& persistent_tree<T, Allocator>::getLeaf(size_type pos) const noexcept
+    {
+        return toLeaf(pos >= getTailOffset() ? *tail : *getTreeLeaf(pos)).values;
+    }
+
+    template <typename T, typename Allocator>
+    const std::shared_ptr<typename persistent_tree<T, Allocator>::node>& persistent_tree<T, Allocator>::getTreeLeaf(size_type pos) const noexcept
+    {
+        const std::shared_ptr<node>* n = &root;
+        for (auto level = shift; level > 0; level -= bits) {
+            n = &toBranch(**n).children[(pos >> level) & mask];
+        }
+        return *n;
+    }
+
+    template <typename T, typename Allocator>
+    template <typename U>
+    void persistent_tree<T, Allocator>::pushBack(std::uint64_t owner, U&& value)
+    {
+        if (size - getTailOffset() < branching) {
+            tail = editLeaf(owner, tail);
+            toLeaf(*tail).values.push_back(std::forward<U>(value));
+            ++size;
+            return;
+        }
+        // Value may refer to element of full tail, so it is copied before tail moves into tree.
+        std::shared_ptr<node> newTail = std::allocate_shared<leaf>(leaf_allocator(alloc), owner, alloc);
+        toLeaf(*newTail).values.push_back(std::forward<U>(value));
+        pushTail(owner);
+        tail = std::move(newTail);
+        ++size;
+    }
+
+    template <typename T, typename Allocator>
+    template <typename U>
+    void persistent_tree<T, Allocator>::set(std::uint64_t owner, size_type pos, U&& value)
+    {
+        if (pos >= getTailOffset()) {
+            tail = editLeaf(owner, tail);
+            toLeaf(*tail).values[pos & mask] = std::forward<U>(value);
+            return;
+        }
+        root = setInTree(owner, shift, root, pos, std::forward<U>(value));
+    }
+
+    template <typename T, typename Allocator>
+    void persistent_tree<T, Allocator>::popBack(std::uint64_t owner)
+    {
+        if (size == 1) {
+            root.reset();
+            tail.reset();
+            shift = bits;
+            size = 0;
+            return;
+        }
+        if (size - getTailOffset() > 1) {
+            tail = editLeaf(owner, tail);
+            toLeaf(*tail).values.pop_back();
+            --size;
+            return;
+        }
+        // Last leaf of tree becomes the tail.
+        auto newTail = getTreeLeaf(size - 2);
+        auto newRoot = removeLastLeaf(owner, shift, root);
+        auto newShift = shift;
+        if (newRoot == nullptr) {
+            newShift = bits;
+        } else if (newShift > bits && toBranch(*newRoot).children[1] == nullptr) {
+            newRoot = toBranch(*newRoot).children[0];
+            newShift -= bits;
+        }
+        root = std::move(newRoot);
+        shift = newShift;
+        tail = std::move(newTail);
+        --size;
+    }
+
+    template <typename T, typename Allocator>
+    std::shared_ptr<typename persistent_tree<T, Allocator>::node> persistent_tree<T, Allocator>::editLeaf(std::uint64_t owner, const std::shared_ptr<node>& n) const
+    {
+        if (n == nullptr) {
+            return std::allocate_shared<leaf>(leaf_allocator(alloc), owner, alloc);
+        }
+        return n->owner == owner ? n : std::allocate_shared<leaf>(leaf_allocator(alloc), owner, toLeaf(*n));
+    }
+
+    // Branch owned by transient has only owned ancestors, hence editing path
+    // top-down never copies a node above one which was already modified in place.
+    template <typename T, typename Allocator>
+    std::shared_ptr<typename persistent_tree<T, Allocator>::node> persistent_tree<T, Allocator>::editBranch(std::uint64_t owner, const std::shared_ptr<node>& n) const
+    {
+        if (n == nullptr) {
+            auto result = std::allocate_shared<branch>(branch_allocator(alloc));
+            result->owner = owner;
+            return result;
+        }
+        if (n->owner == owner) {
+            return n;
+        }
+        auto result = std::allocate_shared<branch>(branch_allocator(alloc), toBranch(*n));
+        result->owner = owner;
+        return result;
+    }
+
+    // Moves full tail into tree, growing new root level when current one is full.
+    template <typename T, typename Allocator>
+    void persistent_tree<T, Allocator>::pushTail(std::uint64_t owner)
+    {
+        auto newRoot = root;
+        auto newShift = shift;
+        if ((size >> bits) > (size_type { 1 } << shift)) {
+            newRoot = editBranch(owner, nullptr);
+            toBranch(*newRoot).children[0] = root;
+            newShift += bits;
+        }
+        root = insertTail(owner, newShift, newRoot);
+        shift = newShift;
+    }
+
+    template <typename T, typename Allocator>
+    std::shared_ptr<typename persistent_tree<T, Allocator>::node> persistent_tree<T, Allocator>::insertTail(std::uint64_t owner, size_type level, const std::shared_ptr<node>& n) const
+    {
+        auto result = editBranch(owner, n);
+        auto& child = toBranch(*result).children[((size - 1) >> level) & mask];
+        child = level == bits ? tail : insertTail(owner, level - bits, child);
+        return result;
+    }
+
+    template <typename T, typename Allocator>
+    template <typename U>
+    std::shared_ptr<typename persistent_tree<T, Allocator>::node> persistent_tree<T, Allocator>::setInTree(std::uint64_t owner, size_type level, const std::shared_ptr<node>& n, size_type pos, U&& value) const
+    {
+        if (level == 0) {
+            auto result = editLeaf(owner, n);
+            toLeaf(*result).values[pos & mask] = std::forward<U>(value);
+            return result;
+        }
+        auto result = editBranch(owner, n);
+        auto& child = toBranch(*result).children[(pos >> level) & mask];
+        child = setInTree(owner, level - bits, child, pos, std::forward<U>(value));
+        return result;
+    }
+
+    template <typename T, typename Allocator>
+    std::shared_ptr<typename persistent_tree<T, Allocator>::node> persistent_tree<T, Allocator>::removeLastLeaf(std::uint64_t owner, size_type level, const std::shared_ptr<node>& n) const
+    {
+        const auto index = ((size - 2) >> level) & mask;
+        std::shared_ptr<node> child;
+        if (level > bits) {
+            child = removeLastLeaf(owner, level - bits, toBranch(*n).children[index]);
+        }
+        if (child == nullptr && index == 0) {
+            return nullptr;
+        }
+        auto result = editBranch(owner, n);
+        toBranch(*result).children[index] = std::move(child);
+        return result;
+    }
+
+    template <typename T, typename Allocator>
+    class persistent_vector_iterator {
+        using tree_type = persistent_tree<T, Allocator>;
+
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        persistent_vector_iterator() = default;
+        persistent_vector_iterator(const tree_type* tree, std::size_t index)
+            : tree_ { tree }
+            , index_ { index }
+        {
+        }
+
+        reference operator*() const;
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        persistent_vector_iterator& operator++()
+        {
+            ++index_;
+            return *this;
+        }
+        persistent_vector_iterator operator++(int)
+        {
+            auto copy = *this;
+            ++index_;
+            return copy;
+        }
+        persistent_vector_iterator& operator--()
+        {
+            --index_;
+            return *this;
+        }
+        persistent_vector_iterator operator--(int)
+        {
+            auto copy = *this;
+            --index_;
+            return copy;
+        }
+        persistent_vector_iterator& operator+=(difference_type n)
+        {
+            index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + n);
+            return *this;
+        }
+        persistent_vector_iterator& operator-=(difference_type n) { return *this += -n; }
+
+        friend persistent_vector_iterator operator+(persistent_vector_iterator it, difference_type n) { return it += n; }
+        friend persistent_vector_iterator operator+(difference_type n, persistent_vector_iterator it) { return it += n; }
+        friend persistent_vector_iterator operator-(persistent_vector_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const persistent_vector_iterator& lhs, const persistent_vector_iterator& rhs)
+        {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+        friend bool operator==(const persistent_vector_iterator& lhs, const persistent_vector_iterator& rhs) { return lhs.index_ == rhs.index_; }
+        friend auto operator<=>(const persistent_vector_iterator& lhs, const persistent_vector_iterator& rhs) { return lhs.index_ <=> rhs.index_; }
+
+    private:
+        constexpr static std::size_t noLeaf_ = std::numeric_limits<std::size_t>::max();
+
+        const tree_type* tree_ = nullptr;
+        std::size_t index_ = 0;
+        // Leaf of the last dereferenced element, looked up again only when iterator leaves it.
+        mutable const T* leaf_ = nullptr;
+        mutable std::size_t leafIndex_ = noLeaf_;
+    };
+
+    template <typename T, typename Allocator>
+    typename persistent_vector_iterator<T, Allocator>::reference persistent_vector_iterator<T, Allocator>::operator*() const
+    {
+        if (leafIndex_ != (index_ >> tree_type::bits)) {
+            leaf_ = tree_->getLeaf(index_).data();
+            leafIndex_ = index_ >> tree_type::bits;
+        }
+        return leaf_[index_ & tree_type::mask];
+    }
+}
+
+template <typename T, typename Allocator = my_alloc::allocator<T>>
+class persistent_vector {
+    using tree_type = detail::persistent_tree<T, Allocator>;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = const value_type&;
+    using const_reference = const value_type&;
+    using iterator = detail::persistent_vector_iterator<T, Allocator>;
+    using const_iterator = iterator;
+    using vector_type = vector<T, Allocator>;
+    using transient_type = transient_vector<T, Allocator>;
+
+    persistent_vector() noexcept(noexcept(Allocator())) = default;
+    explicit persistent_vector(const Allocator& alloc) noexcept;
+    explicit persistent_vector(const vector_type& values);
+    persistent_vector(std::initializer_list<T> init, const Allocator& alloc = Allocator());
+    template <std::input_iterator InputIt>
+    persistent_vector(InputIt first, InputIt last, const Allocator& alloc = Allocator());
+
+    allocator_type get_allocator() const noexcept { return tree_.alloc; }
+
+    const_reference at(size_type pos) const;
+    const_reference operator[](size_type pos) const { return tree_.getLeaf(pos)[pos & tree_type::mask]; }
+    const_reference front() const { return (*this)[0]; }
+    const_reference back() const { return (*this)[size() - 1]; }
+
+    const_iterator begin() const noexcept { return const_iterator(&tree_, 0); }
+    const_iterator end() const noexcept { return const_iterator(&tree_, size()); }
+
+    [[nodiscard]] bool empty() const noexcept { return tree_.size == 0; }
+    size_type size() const noexcept { return tree_.size; }
+
+    [[nodiscard]] persistent_vector push_back(const T& value) const;
+    [[nodiscard]] persistent_vector push_back(T&& value) const;
+    [[nodiscard]] persistent_vector set(size_type pos, const T& value) const;
+    [[nodiscard]] persistent_vector set(size_type pos, T&& value) const;
+    [[nodiscard]] persistent_vector pop_back() const;
+
+    transient_type transient() const { return transient_type(tree_); }
+    vector_type to_vector() const;
+
+private:
+    friend transient_type;
+
+    tree_type tree_;
+
+    explicit persistent_vector(tree_type tree) noexcept
+        : tree_ { std::move(tree) }
+    {
+    }
+};
+
+template <typename T, typename Allocator = my_alloc::allocator<T>>
+class transient_vector {
+    using tree_type = detail::persistent_tree<T, Allocator>;
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using const_reference = const value_type&;
+
+    explicit transient_vector(const Allocator& alloc = Allocator());
+    transient_vector(const transient_vector&) = delete;
+    transient_vector& operator=(const transient_vector&) = delete;
+    transient_vector(transient_vector&& other) noexcept;
+    transient_vector& operator=(transient_vector&& other) noexcept;
+    ~transient_vector() = default;
+
+    const_reference at(size_type pos) const;
+    const_reference operator[](size_type pos) const { return tree_.getLeaf(pos)[pos & tree_type::mask]; }
+
+    [[nodiscard]] bool empty() const noexcept { return tree_.size == 0; }
+    size_type size() const noexcept { return tree_.size; }
+
+    void push_back(const T& value) { tree_.pushBack(owner_, value); }
+    void push_back(T&& value) { tree_.pushBack(owner_, std::move(value)); }
+    void set(size_type pos, const T& value);
+    void set(size_type pos, T&& value);
+    void pop_back();
+
+    // O(1), transient stays usable and copies nodes shared with result on next change.
+    persistent_vector<T, Allocator> persistent();
+
+private:
+    friend class persistent_vector<T, Allocator>;
+
+    tree_type tree_;
+    std::uint64_t owner_;
+
+    explicit transient_vector(const tree_type& tree);
+    tree_type takeTree() && noexcept { return std::move(tree_); }
+};
+
+template <typename T, typename Allocator>
+persistent_vector<T, Allocator>::persistent_vector(const Allocator& alloc) noexcept
+    : tree_ { alloc }
+{
+}
+
+template <typename T, typename Allocator>
+persistent_vector<T, Allocator>::persistent_vector(const vector_type& values)
+    : persistent_vector(values.begin(), values.end(), values.get_allocator())
+{
+}
+
+template <typename T, typename Allocator>
+persistent_vector<T, Allocator>::persistent_vector(std::initializer_list<T> init, const Allocator& alloc)
+    : persistent_vector(init.begin(), init.end(), alloc)
+{
+}
+
+template <typename T, typename Allocator>
+template <std::input_iterator InputIt>
+persistent_vector<T, Allocator>::persistent_vector(InputIt first, InputIt last, const Allocator& alloc)
+{
+    transient_type building(alloc);
+    for (; first != last; ++first) {
+        building.push_back(*first);
+    }
+    tree_ = std::move(building).takeTree();
+}
+
+template <typename T, typename Allocator>
+typename persistent_vector<T, Allocator>::const_reference persistent_vector<T, Allocator>::at(size_type pos) const
+{
+    if (pos >= size()) {
+        throw std::out_of_range { "Position not within range of persistent_vector" };
+    }
+    return (*this)[pos];
+}
+
+template <typename T, typename Allocator>
+persistent_vector<T, Allocator> persistent_vector<T, Allocator>::push_back(const T& value) const
+{
+    auto result = transient();
+    result.push_back(value);
+    return persistent_vector(std::move(result).takeTree());
+}
+
+template <typename T, typename Allocator>
+persistent_vector<T, Allocator> persistent_vector<T, Allocator>::push_back(T&& value) const
+{
+    auto result = transient();
+    result.push_back(std::move(value));
+    return persistent_vector(std::move(result).takeTree());
+}
+
+template <typename T, typename Allocator>
+persistent_vector<T, Allocator> persistent_vector<T, Allocator>::set(size_type pos, const T& value) const
+{
+    auto result = transient();
+    result.set(pos, value);
+    return persistent_vector(std::move(result).takeTree());
+}
+
+template <typename T, typename Allocator>
+persistent_vector<T, Allocator> persistent_vector<T, Allocator>::set(size_type pos, T&& value) const
+{
+    auto result = transient();
+    result.set(pos, std::move(value));
+    return persistent_vector(std::move(result).takeTree());
+}
+
+template <typename T, typename Allocator>
+persistent_vector<T, Allocator> persistent_vector<T, Allocator>::pop_back() const
+{
+    if (empty()) {
+        throw std::out_of_range { "Cannot pop back from empty persistent_vector" };
+    }
+    auto result = transient();
+    result.pop_back();
+    return persistent_vector(std::move(result).takeTree());
+}
+
+template <typename T, typename Allocator>
+typename persistent_vector<T, Allocator>::vector_type persistent_vector<T, Allocator>::to_vector() const
+{
+    vector_type result(tree_.alloc);
+    result.reserve(size());
+    for (size_type pos = 0; pos < size(); pos += tree_type::branching) {
+        result.append_range(tree_.getLeaf(pos));
+    }
+    return result;
+}
+
+template <typename T, typename Allocator>
+bool operator==(const persistent_vector<T, Allocator>& lhs, const persistent_vector<T, Allocator>& rhs)
+{
+    return lhs.size() == rhs.size() && std::equal(lhs.begin(), lhs.end(), rhs.begin());
+}
+
+template <typename T, typename Allocator>
+auto operator<=>(const persistent_vector<T, Allocator>& lhs, const persistent_vector<T, Allocator>& rhs)
+{
+    return std::lexicographical_compare_three_way(lhs.begin(), lhs.end(), rhs.begin(), rhs.end(), std::compare_three_way());
+}
+
+template <typename T, typename Allocator>
+transient_vector<T, Allocator>::transient_vector(const Allocator& alloc)
+    : tree_ { alloc }
+    , owner_ { detail::makeTransientOwner() }
+{
+}
+
+template <typename T, typename Allocator>
+transient_vector<T, Allocator>::transient_vector(const tree_type& tree)
+    : tree_ { tree }
+    , owner_ { detail::makeTransientOwner() }
+{
+}
+
+template <typename T, typename Allocator>
+transient_vector<T, Allocator>::transient_vector(transient_vector&& other) noexcept
+    : tree_ { std::exchange(other.tree_, tree_type { other.tree_.alloc }) }
+    , owner_ { std::exchange(other.owner_, detail::makeTransientOwner()) }
+{
+}
+
+template <typename T, typename Allocator>
+transient_vector<T, Allocator>& transient_vector<T, Allocator>::operator=(transient_vector&& other) noexcept
+{
+    tree_ = std::exchange(other.tree_, tree_type { other.tree_.alloc });
+    owner_ = std::exchange(other.owner_, detail::makeTransientOwner());
+    return *this;
+}
+
+template <typename T, typename Allocator>
+typename transient_vector<T, Allocator>::const_reference transient_vector<T, Allocator>::at(size_type pos) const
+{
+    if (pos >= size()) {
+        throw std::out_of_range { "Position not within range of transient_vector" };
+    }
+    return (*this)[pos];
+}
+
+template <typename T, typename Allocator>
+void transient_vector<T, Allocator>::set(size_type pos, const T& value)
+{
+    if (pos >= size()) {
+        throw std::out_of_range { "Position not within range of transient_vector" };
+    }
+    tree_.set(owner_, pos, value);
+}
+
+template <typename T, typename Allocator>
+void transient_vector<T, Allocator>::set(size_type pos, T&& value)
+{
+    if (pos >= size()) {
+        throw std::out_of_range { "Position not within range of transient_vector" };
+    }
+    tree_.set(owner_, pos, std::move(value));
+}
+
+template <typename T, typename Allocator>
+void transient_vector<T, Allocator>::pop_back()
+{
+    if (empty()) {
+        throw std::out_of_range { "Cannot pop back from empty transient_vector" };
+    }
+    tree_.popBack(owner_);
+}
+
+template <typename T, typename Allocator>
+persistent_vector<T, Allocator> transient_vector<T, Allocator>::persistent()
+{
+    persistent_vector<T, Allocator> result(tree_);
+    owner_ = detail::makeTransientOwner();
+    return result;
+}
+}
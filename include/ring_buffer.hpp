@@ -0,0 +1,413 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "allocator.hpp"
+
+namespace my_vec {
+/*
+* Double-ended circular queue over a single buffer whose capacity is a power
+* of two, so logical position maps to slot with a mask instead of modulo.
+* Elements are added and removed at both ends in O(1) without shifting others.
+* Stored elements occupy at most two contiguous segments which as_spans()
+* exposes for bulk copies or scatter/gather I/O.
+* Full buffer grows to twice its capacity by default, buffer created with
+* overwrite_oldest tag keeps its capacity and drops element at opposite end.
+*/
+
+struct overwrite_oldest_t {
+    explicit overwrite_oldest_t() = default;
+};
+inline constexpr overwrite_oldest_t overwrite_oldest {};
+
+namespace detail {
+    template <typename T>
+    class ring_buffer_iterator {
+    public:
+        using iterator_concept = std::random_access_iterator_tag;
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_cv_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        ring_buffer_iterator() = default;
+        ring_buffer_iterator(T* elem, std::size_t mask, std::size_t head, std::size_t index)
+            : elem_ { elem }
+            , mask_ { mask }
+            , head_ { head }
+            , index_ { index }
+        {
+        }
+        template <typename U>
+            requires std::is_same_v<const U, T>
+        ring_buffer_iterator(const ring_buffer_iterator<U>& other)
+            : elem_ { other.elem_ }
+            , mask_ { other.mask_ }
+            , head_ { other.head_ }
+            , index_ { other.index_ }
+        {
+        }
+
+        reference operator*() const { return elem_[(head_ + index_) & mask_]; }
+        pointer operator->() const { return &**this; }
+        reference operator[](difference_type n) const { return *(*this + n); }
+
+        ring_buffer_iterator& operator++()
+        {
+            ++index_;
+            return *this;
+        }
+        ring_buffer_iterator operator++(int)
+        {
+            auto copy = *this;
+            ++index_;
+            return copy;
+        }
+        ring_buffer_iterator& operator--()
+        {
+            --index_;
+            return *this;
+        }
+        ring_buffer_iterator operator--(int)
+        {
+            auto copy = *this;
+            --index_;
+            return copy;
+        }
+        ring_buffer_iterator& operator+=(difference_type n)
+        {
+            index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + n);
+            return *this;
+        }
+        ring_buffer_iterator& operator-=(difference_type n) { return *this += -n; }
+
+        friend ring_buffer_iterator operator+(ring_buffer_iterator it, difference_type n) { return it += n; }
+        friend ring_buffer_iterator operator+(difference_type n, ring_buffer_iterator it) { return it += n; }
+        friend ring_buffer_iterator operator-(ring_buffer_iterator it, difference_type n) { return it -= n; }
+        friend difference_type operator-(const ring_buffer_iterator& lhs, const ring_buffer_iterator& rhs)
+        {
+            return static_cast<difference_type>(lhs.index_) - static_cast<difference_type>(rhs.index_);
+        }
+        friend bool operator==(const ring_buffer_iterator& lhs, const ring_buffer_iterator& rhs) { return lhs.index_ == rhs.index_; }
+        friend auto operator<=>(const ring_buffer_iterator& lhs, const ring_buffer_iterator& rhs) { return lhs.index_ <=> rhs.index_; }
+
+    private:
+        template <typename>
+        friend class ring_buffer_iterator;
+
+        T* elem_ = nullptr;
+        std::size_t mask_ = 0;
+        std::size_t head_ = 0;
+        // Logical position counted from front, iterators stay comparable when head wraps around.
+        std::size_t index_ = 0;
+    };
+}
+
+template <typename T, typename Allocator = my_alloc::allocator<T>>
+class ring_buffer {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using difference_type = std::ptrdiff_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = detail::ring_buffer_iterator<T>;
+    using const_iterator = detail::ring_buffer_iterator<const T>;
+
+    ring_buffer() noexcept(noexcept(Allocator())) = default;
+    explicit ring_buffer(size_type capacity, const Allocator& alloc = Allocator());
+    ring_buffer(size_type capacity, overwrite_oldest_t, const Allocator& alloc = Allocator());
+    ring_buffer(const ring_buffer& other);
+    ring_buffer& operator=(const ring_buffer& other);
+    ring_buffer(ring_buffer&& other) noexcept;
+    ring_buffer& operator=(ring_buffer&& other) noexcept;
+    ~ring_buffer() noexcept;
+
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    reference at(size_type pos);
+    const_reference at(size_type pos) const;
+    reference operator[](size_type pos) { return elem_[getSlot(pos)]; }
+    const_reference operator[](size_type pos) const { return elem_[getSlot(pos)]; }
+    reference front() { return elem_[head_]; }
+    const_reference front() const { return elem_[head_]; }
+    reference back() { return elem_[getSlot(size_ - 1)]; }
+    const_reference back() const { return elem_[getSlot(size_ - 1)]; }
+
+    iterator begin() noexcept { return { elem_, capacity_ - 1, head_, 0 }; }
+    const_iterator begin() const noexcept { return { elem_, capacity_ - 1, head_, 0 }; }
+    iterator end() noexcept { return { elem_, capacity_ - 1, head_, size_ }; }
+    const_iterator end() const noexcept { return { elem_, capacity_ - 1, head_, size_ }; }
+
+    // Stored elements in order: first span starts at front, second one, possibly empty, continues at start of buffer.
+    std::pair<std::span<T>, std::span<T>> as_spans() noexcept;
+    std::pair<std::span<const T>, std::span<const T>> as_spans() const noexcept;
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    [[nodiscard]] bool full() const noexcept { return size_ == capacity_; }
+    size_type size() const noexcept { return size_; }
+    size_type capacity() const noexcept { return capacity_; }
+    bool overwrites_oldest() const noexcept { return overwrite_; }
+    void reserve(size_type new_cap);
+
+    void clear() noexcept;
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+    void push_front(const T& value) { emplace_front(value); }
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+    template <typename... Args>
+    reference emplace_back(Args&&... args);
+    template <typename... Args>
+    reference emplace_front(Args&&... args);
+    void pop_back();
+    void pop_front();
+    void swap(ring_buffer& other) noexcept;
+
+private:
+    [[no_unique_address]] Allocator alloc_ {};
+    T* elem_ = nullptr;
+    size_type capacity_ = 0;
+    size_type head_ = 0;
+    size_type size_ = 0;
+    bool overwrite_ = false;
+
+    size_type getSlot(size_type pos) const noexcept { return (head_ + pos) & (capacity_ - 1); }
+    static size_type getRoundedCapacity(size_type capacity) { return capacity == 0 ? 0 : std::bit_ceil(capacity); }
+    template <typename Construct = std::nullptr_t>
+    void reallocate(size_type new_cap, bool atFront = false, Construct construct = nullptr);
+};
+
+template <typename T, typename Allocator>
+ring_buffer<T, Allocator>::ring_buffer(size_type capacity, const Allocator& alloc)
+    : alloc_ { alloc }
+{
+    reserve(capacity);
+}
+
+template <typename T, typename Allocator>
+ring_buffer<T, Allocator>::ring_buffer(size_type capacity, overwrite_oldest_t, const Allocator& alloc)
+    : alloc_ { alloc }
+    , overwrite_ { true }
+{
+    reserve(capacity);
+}
+
+template <typename T, typename Allocator>
+ring_buffer<T, Allocator>::ring_buffer(const ring_buffer& other)
+    : alloc_ { other.alloc_ }
+    , overwrite_ { other.overwrite_ }
+{
+    reserve(other.capacity_);
+    for (const auto& value : other) {
+        emplace_back(value);
+    }
+}
+
+template <typename T, typename Allocator>
+ring_buffer<T, Allocator>& ring_buffer<T, Allocator>::operator=(const ring_buffer& other)
+{
+    if (this != &other) {
+        ring_buffer copy { other };
+        swap(copy);
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator>
+ring_buffer<T, Allocator>::ring_buffer(ring_buffer&& other) noexcept
+    : alloc_ { other.alloc_ }
+    , elem_ { std::exchange(other.elem_, nullptr) }
+    , capacity_ { std::exchange(other.capacity_, 0) }
+    , head_ { std::exchange(other.head_, 0) }
+    , size_ { std::exchange(other.size_, 0) }
+    , overwrite_ { other.overwrite_ }
+{
+}
+
+template <typename T, typename Allocator>
+ring_buffer<T, Allocator>& ring_buffer<T, Allocator>::operator=(ring_buffer&& other) noexcept
+{
+    if (this != &other) {
+        ring_buffer moved { std::move(other) };
+        swap(moved);
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator>
+ring_buffer<T, Allocator>::~ring_buffer() noexcept
+{
+    clear();
+    if (elem_ != nullptr) {
+        alloc_.deallocate(elem_, capacity_);
+    }
+}
+
+template <typename T, typename Allocator>
+typename ring_buffer<T, Allocator>::reference ring_buffer<T, Allocator>::at(size_type pos)
+{
+    if (pos >= size_) {
+        throw std::out_of_range { "Position not within range of ring_buffer" };
+    }
+    return (*this)[pos];
+}
+
+template <typename T, typename Allocator>
+typename ring_buffer<T, Allocator>::const_reference ring_buffer<T, Allocator>::at(size_type pos) const
+{
+    if (pos >= size_) {
+        throw std::out_of_range { "Position not within range of ring_buffer" };
+    }
+    return (*this)[pos];
+}
+
+template <typename T, typename Allocator>
+std::pair<std::span<T>, std::span<T>> ring_buffer<T, Allocator>::as_spans() noexcept
+{
+    const auto firstSize = std::min(size_, capacity_ - head_);
+    return { std::span<T> { elem_ + head_, firstSize }, std::span<T> { elem_, size_ - firstSize } };
+}
+
+template <typename T, typename Allocator>
+std::pair<std::span<const T>, std::span<const T>> ring_buffer<T, Allocator>::as_spans() const noexcept
+{
+    const auto firstSize = std::min(size_, capacity_ - head_);
+    return { std::span<const T> { elem_ + head_, firstSize }, std::span<const T> { elem_, size_ - firstSize } };
+}
+
+// Capacity is rounded up to power of two, buffer never shrinks.
+template <typename T, typename Allocator>
+void ring_buffer<T, Allocator>::reserve(size_type new_cap)
+{
+    new_cap = getRoundedCapacity(new_cap);
+    if (new_cap > capacity_) {
+        reallocate(new_cap);
+    }
+}
+
+template <typename T, typename Allocator>
+void ring_buffer<T, Allocator>::clear() noexcept
+{
+    for (size_type i = 0; i < size_; ++i) {
+        std::destroy_at(elem_ + getSlot(i));
+    }
+    head_ = 0;
+    size_ = 0;
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename ring_buffer<T, Allocator>::reference ring_buffer<T, Allocator>::emplace_back(Args&&... args)
+{
+    if (full()) {
+        if (!overwrite_ || capacity_ == 0) {
+            reallocate(capacity_ == 0 ? 1 : 2 * capacity_, false, [&](T* slot) { std::construct_at(slot, std::forward<Args>(args)...); });
+            return back();
+        }
+        // Temporary is built before oldest element is replaced, args may refer to it.
+        elem_[head_] = T(std::forward<Args>(args)...);
+        head_ = getSlot(1);
+        return back();
+    }
+    std::construct_at(elem_ + getSlot(size_), std::forward<Args>(args)...);
+    ++size_;
+    return back();
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename ring_buffer<T, Allocator>::reference ring_buffer<T, Allocator>::emplace_front(Args&&... args)
+{
+    if (full()) {
+        if (!overwrite_ || capacity_ == 0) {
+            reallocate(capacity_ == 0 ? 1 : 2 * capacity_, true, [&](T* slot) { std::construct_at(slot, std::forward<Args>(args)...); });
+            return front();
+        }
+        const auto slot = getSlot(size_ - 1);
+        elem_[slot] = T(std::forward<Args>(args)...);
+        head_ = slot;
+        return front();
+    }
+    const auto slot = getSlot(capacity_ - 1);
+    std::construct_at(elem_ + slot, std::forward<Args>(args)...);
+    head_ = slot;
+    ++size_;
+    return front();
+}
+
+template <typename T, typename Allocator>
+void ring_buffer<T, Allocator>::pop_back()
+{
+    std::destroy_at(elem_ + getSlot(size_ - 1));
+    --size_;
+}
+
+template <typename T, typename Allocator>
+void ring_buffer<T, Allocator>::pop_front()
+{
+    std::destroy_at(elem_ + head_);
+    head_ = getSlot(1);
+    --size_;
+}
+
+template <typename T, typename Allocator>
+void ring_buffer<T, Allocator>::swap(ring_buffer& other) noexcept
+{
+    std::swap(alloc_, other.alloc_);
+    std::swap(elem_, other.elem_);
+    std::swap(capacity_, other.capacity_);
+    std::swap(head_, other.head_);
+    std::swap(size_, other.size_);
+    std::swap(overwrite_, other.overwrite_);
+}
+
+// Moves elements to new buffer starting at its first slot. Given construct builds new element first, at
+// the back or in the last slot as new front, because its arguments may refer to a stored element.
+template <typename T, typename Allocator>
+template <typename Construct>
+void ring_buffer<T, Allocator>::reallocate(size_type new_cap, bool atFront, Construct construct)
+{
+    constexpr bool emplacing = !std::is_null_pointer_v<Construct>;
+    T* newElem = alloc_.allocate(new_cap);
+    const auto emplacedSlot = atFront ? new_cap - 1 : size_;
+    bool emplaced = false;
+    size_type relocated = 0;
+    try {
+        if constexpr (emplacing) {
+            construct(newElem + emplacedSlot);
+            emplaced = true;
+        }
+        for (; relocated < size_; ++relocated) {
+            std::construct_at(newElem + relocated, std::move_if_noexcept(elem_[getSlot(relocated)]));
+        }
+    } catch (...) {
+        std::destroy(newElem, newElem + relocated);
+        if (emplaced) {
+            std::destroy_at(newElem + emplacedSlot);
+        }
+        alloc_.deallocate(newElem, new_cap);
+        throw;
+    }
+
+    const auto oldSize = size_;
+    clear();
+    if (elem_ != nullptr) {
+        alloc_.deallocate(elem_, capacity_);
+    }
+    elem_ = newElem;
+    capacity_ = new_cap;
+    head_ = emplacing && atFront ? new_cap - 1 : 0;
+    size_ = oldSize + (emplacing ? 1 : 0);
+}
+}
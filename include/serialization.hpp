@@ -0,0 +1,214 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+
+#include "vector.hpp"
+
+namespace my_vec {
+/*
+* Binary serialization of vectors of trivially copyable elements.
+* Format is a fixed 24 byte header followed by raw payload:
+*   magic "MVEC" | version u16 | endianness u8 | kind u8 | element size u32 | count u64
+* Header and payload are written in native byte order, endianness field lets
+* reader swap bytes of arithmetic payloads written on machine of other order.
+* Payload is transferred with one bulk write/read straight from/into vector storage,
+* vector<bool> stores its 64-bit blocks with bits past size() cleared.
+* Count from header is validated before any storage is reserved: payload size
+* must fit in size_t and, for seekable streams, in bytes left in the stream.
+*/
+
+namespace detail {
+    constexpr std::array<char, 4> serializationMagic { 'M', 'V', 'E', 'C' };
+    constexpr std::uint16_t serializationVersion = 1;
+
+    enum class payload_kind : std::uint8_t {
+        elements = 0,
+        bits = 1
+    };
+
+    enum class byte_order : std::uint8_t {
+        little = 1,
+        big = 2
+    };
+
+    constexpr byte_order nativeByteOrder = std::endian::native == std::endian::little ? byte_order::little : byte_order::big;
+
+    struct serialization_header {
+        std::array<char, 4> magic;
+        std::uint16_t version;
+        byte_order endianness;
+        payload_kind kind;
+        std::uint32_t elementSize;
+        std::uint32_t reserved;
+        std::uint64_t count;
+    };
+    static_assert(sizeof(serialization_header) == 24);
+
+    template <typename U>
+    constexpr U byteSwap(U value) noexcept
+    {
+        auto bytes = std::bit_cast<std::array<unsigned char, sizeof(U)>>(value);
+        std::reverse(bytes.begin(), bytes.end());
+        return std::bit_cast<U>(bytes);
+    }
+
+    inline void writeHeader(std::ostream& out, payload_kind kind, std::size_t elementSize, std::size_t count)
+    {
+        const serialization_header header {
+            serializationMagic,
+            serializationVersion,
+            nativeByteOrder,
+            kind,
+            static_cast<std::uint32_t>(elementSize),
+            0,
+            static_cast<std::uint64_t>(count)
+        };
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    }
+
+    // Returns true when payload was written in opposite byte order.
+    inline bool readHeader(std::istream& in, payload_kind kind, std::size_t elementSize, std::uint64_t& count)
+    {
+        serialization_header header {};
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof(header))) {
+            throw std::runtime_error { "Stream ended before vector header" };
+        }
+        if (header.magic != serializationMagic) {
+            throw std::runtime_error { "Stream does not contain serialized vector" };
+        }
+
+        const bool swapped = header.endianness != nativeByteOrder;
+        if (swapped) {
+            header.version = byteSwap(header.version);
+            header.elementSize = byteSwap(header.elementSize);
+            header.count = byteSwap(header.count);
+        }
+        if (header.version != serializationVersion) {
+            throw std::runtime_error { "Unsupported version of serialized vector" };
+        }
+        if (header.kind != kind || header.elementSize != elementSize) {
+            throw std::runtime_error { "Serialized vector holds elements of other type" };
+        }
+        count = header.count;
+        return swapped;
+    }
+
+    // Returns payload size in bytes, throws when header promises more than can be read.
+    inline std::size_t getPayloadSize(std::istream& in, std::uint64_t count, std::size_t elementSize)
+    {
+        if (count > std::numeric_limits<std::size_t>::max() / elementSize) {
+            throw std::runtime_error { "Serialized vector is too large" };
+        }
+        const auto bytes = static_cast<std::size_t>(count) * elementSize;
+
+        // Streams which cannot seek (e.g. pipes) are checked only while reading payload.
+        const auto pos = in.tellg();
+        if (pos == std::istream::pos_type(-1)) {
+            return bytes;
+        }
+        in.seekg(0, std::ios::end);
+        const auto end = in.tellg();
+        in.seekg(pos);
+        if (end == std::istream::pos_type(-1) || !in) {
+            in.clear();
+            in.seekg(pos);
+            return bytes;
+        }
+        if (bytes > static_cast<std::size_t>(end - pos)) {
+            throw std::runtime_error { "Stream ended before end of vector payload" };
+        }
+        return bytes;
+    }
+
+    inline void readPayload(std::istream& in, void* dest, std::size_t bytes)
+    {
+        if (!in.read(static_cast<char*>(dest), static_cast<std::streamsize>(bytes))) {
+            throw std::runtime_error { "Stream ended before end of vector payload" };
+        }
+    }
+}
+
+template <typename T, typename Allocator, typename Stats>
+void serialize(std::ostream& out, const vector<T, Allocator, Stats>& vec)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only vectors of trivially copyable elements can be serialized");
+    detail::writeHeader(out, detail::payload_kind::elements, sizeof(T), vec.size());
+    out.write(reinterpret_cast<const char*>(vec.data()), static_cast<std::streamsize>(vec.size() * sizeof(T)));
+    if (!out) {
+        throw std::runtime_error { "Cannot write vector to stream" };
+    }
+}
+
+inline void serialize(std::ostream& out, const vector<bool>& vec)
+{
+    using block_t = std::uint64_t;
+    const auto* blocks = detail::vector_access::getBlocks(vec);
+    const auto numOfBlocks = detail::vector_access::getNumberOfBlocks(vec);
+
+    detail::writeHeader(out, detail::payload_kind::bits, sizeof(block_t), vec.size());
+    if (numOfBlocks != 0) {
+        out.write(reinterpret_cast<const char*>(blocks), static_cast<std::streamsize>((numOfBlocks - 1) * sizeof(block_t)));
+        const auto usedBits = vec.size() % (8 * sizeof(block_t));
+        const block_t lastBlock = usedBits == 0 ? blocks[numOfBlocks - 1] : blocks[numOfBlocks - 1] & ((block_t { 1 } << usedBits) - 1);
+        out.write(reinterpret_cast<const char*>(&lastBlock), sizeof(lastBlock));
+    }
+    if (!out) {
+        throw std::runtime_error { "Cannot write vector to stream" };
+    }
+}
+
+template <typename T, typename Allocator, typename Stats>
+void deserialize(std::istream& in, vector<T, Allocator, Stats>& vec)
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Only vectors of trivially copyable elements can be deserialized");
+    std::uint64_t count = 0;
+    const bool swapped = detail::readHeader(in, detail::payload_kind::elements, sizeof(T), count);
+    if constexpr (!std::is_arithmetic_v<T>) {
+        if (swapped && sizeof(T) > 1) {
+            throw std::runtime_error { "Cannot convert byte order of non arithmetic elements" };
+        }
+    }
+
+    const auto bytes = detail::getPayloadSize(in, count, sizeof(T));
+    vec.clear();
+    vec.reserve(static_cast<std::size_t>(count));
+    detail::readPayload(in, vec.data(), bytes);
+    if constexpr (std::is_arithmetic_v<T>) {
+        if (swapped) {
+            for (std::size_t i = 0; i < count; ++i) {
+                vec.data()[i] = detail::byteSwap(vec.data()[i]);
+            }
+        }
+    }
+    detail::vector_access::setSize(vec, static_cast<std::size_t>(count));
+}
+
+inline void deserialize(std::istream& in, vector<bool>& vec)
+{
+    using block_t = std::uint64_t;
+    std::uint64_t count = 0;
+    const bool swapped = detail::readHeader(in, detail::payload_kind::bits, sizeof(block_t), count);
+
+    constexpr std::uint64_t bitsPerBlock = 8 * sizeof(block_t);
+    const auto numOfBlocks = count / bitsPerBlock + (count % bitsPerBlock != 0 ? 1 : 0);
+    const auto bytes = detail::getPayloadSize(in, numOfBlocks, sizeof(block_t));
+    vec.clear();
+    vec.reserve(static_cast<std::size_t>(count));
+    auto* blocks = detail::vector_access::getBlocks(vec);
+    detail::readPayload(in, blocks, bytes);
+    if (swapped) {
+        std::transform(blocks, blocks + bytes / sizeof(block_t), blocks, detail::byteSwap<block_t>);
+    }
+    detail::vector_access::setSize(vec, static_cast<std::size_t>(count));
+}
+}
@@ -0,0 +1,221 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+
+#include "vector.hpp"
+
+namespace my_vec {
+/*
+* Container handing out stable keys for elements which stay valid across
+* insertion and erasure of other elements. Elements live densely in one
+* vector, so iteration is as fast as over a plain vector; erase moves the last
+* element into the freed position (swap-and-pop). Key names a slot in an
+* indirection table pointing to dense position, and carries the slot's
+* generation: erasing bumps the generation, so stale keys are detected
+* instead of reaching whichever element later reuses the slot. Freed slots
+* form an intrusive free list and are reused first.
+*
+* Insert, erase and lookup by key are O(1). Keys use 32-bit index and
+* generation, generation wraps around after 2^32 reuses of one slot.
+*/
+
+template <typename T, typename Allocator = my_alloc::allocator<T>>
+class slot_map {
+public:
+    struct key_type {
+        std::uint32_t index = std::numeric_limits<std::uint32_t>::max();
+        std::uint32_t generation = 0;
+
+        friend bool operator==(const key_type& lhs, const key_type& rhs) = default;
+    };
+
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = T*;
+    using const_iterator = const T*;
+
+    slot_map() noexcept(noexcept(Allocator())) = default;
+    explicit slot_map(const Allocator& alloc) noexcept;
+
+    allocator_type get_allocator() const noexcept { return values_.get_allocator(); }
+
+    reference at(key_type key);
+    const_reference at(key_type key) const;
+    reference operator[](key_type key) { return values_[slots_[key.index].index]; }
+    const_reference operator[](key_type key) const { return values_[slots_[key.index].index]; }
+    T* data() noexcept { return values_.data(); }
+    const T* data() const noexcept { return values_.data(); }
+
+    iterator begin() noexcept { return values_.begin(); }
+    const_iterator begin() const noexcept { return values_.begin(); }
+    iterator end() noexcept { return values_.end(); }
+    const_iterator end() const noexcept { return values_.end(); }
+
+    [[nodiscard]] bool empty() const noexcept { return values_.empty(); }
+    size_type size() const noexcept { return values_.size(); }
+    void reserve(size_type new_cap);
+
+    iterator find(key_type key) noexcept { return contains(key) ? begin() + slots_[key.index].index : end(); }
+    const_iterator find(key_type key) const noexcept { return contains(key) ? begin() + slots_[key.index].index : end(); }
+    bool contains(key_type key) const noexcept;
+    key_type key_of(const_iterator pos) const noexcept;
+
+    // Invalidates every key, slots are kept for reuse.
+    void clear() noexcept;
+    key_type insert(const T& value) { return emplace(value); }
+    key_type insert(T&& value) { return emplace(std::move(value)); }
+    template <typename... Args>
+    key_type emplace(Args&&... args);
+    // Returns whether key named an element.
+    bool erase(key_type key);
+    // Last element takes place of the erased one, returned iterator points to it.
+    iterator erase(const_iterator pos);
+
+private:
+    using index_type = std::uint32_t;
+
+    constexpr static index_type noSlot_ = std::numeric_limits<index_type>::max();
+
+    struct slot {
+        // Dense position of the element while occupied, next free slot otherwise.
+        index_type index;
+        index_type generation;
+    };
+
+    using index_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<index_type>;
+    using slot_allocator = typename std::allocator_traits<Allocator>::template rebind_alloc<slot>;
+
+    vector<T, Allocator> values_;
+    vector<index_type, index_allocator> denseToSlot_;
+    vector<slot, slot_allocator> slots_;
+    index_type freeHead_ = noSlot_;
+
+    void releaseSlot(index_type slotIndex) noexcept;
+};
+
+template <typename T, typename Allocator>
+slot_map<T, Allocator>::slot_map(const Allocator& alloc) noexcept
+    : values_(alloc)
+    , denseToSlot_(index_allocator(alloc))
+    , slots_(slot_allocator(alloc))
+{
+}
+
+template <typename T, typename Allocator>
+typename slot_map<T, Allocator>::reference slot_map<T, Allocator>::at(key_type key)
+{
+    if (!contains(key)) {
+        throw std::out_of_range { "Key not within range of slot_map" };
+    }
+    return (*this)[key];
+}
+
+template <typename T, typename Allocator>
+typename slot_map<T, Allocator>::const_reference slot_map<T, Allocator>::at(key_type key) const
+{
+    if (!contains(key)) {
+        throw std::out_of_range { "Key not within range of slot_map" };
+    }
+    return (*this)[key];
+}
+
+template <typename T, typename Allocator>
+void slot_map<T, Allocator>::reserve(size_type new_cap)
+{
+    values_.reserve(new_cap);
+    denseToSlot_.reserve(new_cap);
+    slots_.reserve(new_cap);
+}
+
+template <typename T, typename Allocator>
+bool slot_map<T, Allocator>::contains(key_type key) const noexcept
+{
+    if (key.index >= slots_.size()) {
+        return false;
+    }
+    // Free slot's generation was bumped when it was released, so no issued key matches it.
+    return slots_[key.index].generation == key.generation;
+}
+
+template <typename T, typename Allocator>
+typename slot_map<T, Allocator>::key_type slot_map<T, Allocator>::key_of(const_iterator pos) const noexcept
+{
+    const auto slotIndex = denseToSlot_[static_cast<size_type>(pos - begin())];
+    return key_type { slotIndex, slots_[slotIndex].generation };
+}
+
+template <typename T, typename Allocator>
+void slot_map<T, Allocator>::clear() noexcept
+{
+    for (const auto slotIndex : denseToSlot_) {
+        releaseSlot(slotIndex);
+    }
+    values_.clear();
+    denseToSlot_.clear();
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+typename slot_map<T, Allocator>::key_type slot_map<T, Allocator>::emplace(Args&&... args)
+{
+    if (freeHead_ == noSlot_) {
+        if (slots_.size() == noSlot_) {
+            throw std::length_error { "Number of slots exceeds limit of slot_map" };
+        }
+        // New slot joins free list first, which is valid state if construction below throws.
+        slots_.push_back(slot { noSlot_, 0 });
+        freeHead_ = static_cast<index_type>(slots_.size() - 1);
+    }
+    const auto slotIndex = freeHead_;
+    denseToSlot_.push_back(slotIndex);
+    try {
+        values_.emplace_back(std::forward<Args>(args)...);
+    } catch (...) {
+        denseToSlot_.pop_back();
+        throw;
+    }
+    freeHead_ = slots_[slotIndex].index;
+    slots_[slotIndex].index = static_cast<index_type>(values_.size() - 1);
+    return key_type { slotIndex, slots_[slotIndex].generation };
+}
+
+template <typename T, typename Allocator>
+bool slot_map<T, Allocator>::erase(key_type key)
+{
+    if (!contains(key)) {
+        return false;
+    }
+    erase(begin() + slots_[key.index].index);
+    return true;
+}
+
+template <typename T, typename Allocator>
+typename slot_map<T, Allocator>::iterator slot_map<T, Allocator>::erase(const_iterator pos)
+{
+    const auto dense = static_cast<size_type>(pos - begin());
+    const auto slotIndex = denseToSlot_[dense];
+    auto result = values_.unstable_erase(pos);
+    denseToSlot_.unstable_erase(denseToSlot_.begin() + dense);
+    if (dense < denseToSlot_.size()) {
+        slots_[denseToSlot_[dense]].index = static_cast<index_type>(dense);
+    }
+    releaseSlot(slotIndex);
+    return result;
+}
+
+template <typename T, typename Allocator>
+void slot_map<T, Allocator>::releaseSlot(index_type slotIndex) noexcept
+{
+    ++slots_[slotIndex].generation;
+    slots_[slotIndex].index = freeHead_;
+    freeHead_ = slotIndex;
+}
+}
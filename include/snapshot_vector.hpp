@@ -0,0 +1,238 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "vector.hpp"
+
+namespace my_vec {
+/*
+* RCU-style vector for read-mostly data shared by many threads. Current
+* contents live in an immutable buffer reachable through an atomic pointer;
+* readers take a snapshot without locks and keep seeing the same buffer for
+* snapshot's lifetime. Writers (serialized by a mutex) build a new buffer,
+* either from scratch with publish() or as a modified copy with update(),
+* swap the pointer and advance the global epoch.
+*
+* Each reader announces epoch it entered in one of fixed number of cache-line
+* sized slots. Replaced buffer is tagged with epoch which followed the swap
+* and freed once no announced epoch is older than the tag, i.e. every reader
+* which could have seen it has left. Reclamation is attempted on every write
+* and by reclaim(). When more readers than slots are active at once, a new
+* reader spins until some slot is released.
+*/
+
+template <typename T, typename Allocator = my_alloc::allocator<T>>
+class snapshot_vector {
+    struct alignas(64) reader_slot {
+        std::atomic<std::uint64_t> epoch { idleEpoch_ };
+    };
+
+public:
+    using value_type = T;
+    using size_type = std::size_t;
+    using vector_type = vector<T, Allocator>;
+    using const_reference = const value_type&;
+    using const_iterator = typename vector_type::const_iterator;
+
+    constexpr static size_type defaultReaderSlots = 128;
+
+    class snapshot {
+    public:
+        snapshot(const snapshot&) = delete;
+        snapshot& operator=(const snapshot&) = delete;
+        snapshot(snapshot&& other) noexcept
+            : slot_ { std::exchange(other.slot_, nullptr) }
+            , values_ { other.values_ }
+        {
+        }
+        snapshot& operator=(snapshot&& other) noexcept;
+        ~snapshot() noexcept { release(); }
+
+        const vector_type& values() const noexcept { return *values_; }
+        const_reference at(size_type pos) const;
+        const_reference operator[](size_type pos) const { return (*values_)[pos]; }
+        const T* data() const noexcept { return values_->data(); }
+        const_iterator begin() const noexcept { return values_->begin(); }
+        const_iterator end() const noexcept { return values_->end(); }
+        size_type size() const noexcept { return values_->size(); }
+        [[nodiscard]] bool empty() const noexcept { return values_->empty(); }
+
+    private:
+        friend class snapshot_vector;
+
+        reader_slot* slot_;
+        const vector_type* values_;
+
+        snapshot(reader_slot* slot, const vector_type* values) noexcept
+            : slot_ { slot }
+            , values_ { values }
+        {
+        }
+        void release() noexcept;
+    };
+
+    explicit snapshot_vector(vector_type values = vector_type(), size_type readerSlots = defaultReaderSlots);
+    snapshot_vector(const snapshot_vector&) = delete;
+    snapshot_vector& operator=(const snapshot_vector&) = delete;
+    // No snapshot may outlive snapshot_vector.
+    ~snapshot_vector() noexcept;
+
+    snapshot read() const;
+
+    void publish(vector_type values);
+    template <typename Function>
+    void update(Function&& modify);
+    // Returns number of replaced buffers still waiting for readers to leave.
+    size_type reclaim();
+
+    std::uint64_t epoch() const noexcept { return epoch_.load(std::memory_order_acquire); }
+
+private:
+    constexpr static std::uint64_t idleEpoch_ = 0;
+
+    struct retired_buffer {
+        std::unique_ptr<const vector_type> values;
+        std::uint64_t epoch;
+    };
+
+    std::unique_ptr<reader_slot[]> slots_;
+    size_type numOfSlots_;
+    std::atomic<const vector_type*> current_;
+    std::atomic<std::uint64_t> epoch_ { idleEpoch_ + 1 };
+    std::mutex writerMutex_;
+    std::vector<retired_buffer> retired_;
+
+    reader_slot& enterEpoch() const;
+    void replace(std::unique_ptr<const vector_type> values);
+    size_type reclaimRetired();
+};
+
+template <typename T, typename Allocator>
+typename snapshot_vector<T, Allocator>::snapshot& snapshot_vector<T, Allocator>::snapshot::operator=(snapshot&& other) noexcept
+{
+    if (this != &other) {
+        release();
+        slot_ = std::exchange(other.slot_, nullptr);
+        values_ = other.values_;
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator>
+typename snapshot_vector<T, Allocator>::const_reference snapshot_vector<T, Allocator>::snapshot::at(size_type pos) const
+{
+    if (pos >= size()) {
+        throw std::out_of_range { "Position not within range of snapshot" };
+    }
+    return (*values_)[pos];
+}
+
+template <typename T, typename Allocator>
+void snapshot_vector<T, Allocator>::snapshot::release() noexcept
+{
+    if (slot_ != nullptr) {
+        slot_->epoch.store(idleEpoch_, std::memory_order_release);
+        slot_ = nullptr;
+    }
+}
+
+template <typename T, typename Allocator>
+snapshot_vector<T, Allocator>::snapshot_vector(vector_type values, size_type readerSlots)
+    : slots_ { std::make_unique<reader_slot[]>(std::max<size_type>(readerSlots, 1)) }
+    , numOfSlots_ { std::max<size_type>(readerSlots, 1) }
+    , current_ { new vector_type(std::move(values)) }
+{
+}
+
+template <typename T, typename Allocator>
+snapshot_vector<T, Allocator>::~snapshot_vector() noexcept
+{
+    delete current_.load(std::memory_order_acquire);
+}
+
+template <typename T, typename Allocator>
+typename snapshot_vector<T, Allocator>::snapshot snapshot_vector<T, Allocator>::read() const
+{
+    reader_slot& slot = enterEpoch();
+    // Pointer is loaded after epoch was announced, so writer which swapped it
+    // either sees the announcement or has already published newer buffer.
+    return snapshot(&slot, current_.load(std::memory_order_seq_cst));
+}
+
+template <typename T, typename Allocator>
+void snapshot_vector<T, Allocator>::publish(vector_type values)
+{
+    auto buffer = std::make_unique<const vector_type>(std::move(values));
+    const std::lock_guard lock { writerMutex_ };
+    replace(std::move(buffer));
+}
+
+template <typename T, typename Allocator>
+template <typename Function>
+void snapshot_vector<T, Allocator>::update(Function&& modify)
+{
+    const std::lock_guard lock { writerMutex_ };
+    auto values = std::make_unique<vector_type>(*current_.load(std::memory_order_acquire));
+    std::invoke(std::forward<Function>(modify), *values);
+    replace(std::move(values));
+}
+
+template <typename T, typename Allocator>
+typename snapshot_vector<T, Allocator>::size_type snapshot_vector<T, Allocator>::reclaim()
+{
+    const std::lock_guard lock { writerMutex_ };
+    return reclaimRetired();
+}
+
+template <typename T, typename Allocator>
+typename snapshot_vector<T, Allocator>::reader_slot& snapshot_vector<T, Allocator>::enterEpoch() const
+{
+    thread_local const size_type hint = std::hash<std::thread::id> {}(std::this_thread::get_id());
+    for (size_type i = hint;; ++i) {
+        reader_slot& slot = slots_[i % numOfSlots_];
+        auto expected = idleEpoch_;
+        // Epoch read before the exchange may already be stale, which only delays reclamation.
+        if (slot.epoch.load(std::memory_order_relaxed) == idleEpoch_
+            && slot.epoch.compare_exchange_strong(expected, epoch_.load(std::memory_order_seq_cst), std::memory_order_seq_cst)) {
+            return slot;
+        }
+        if (i - hint + 1 == numOfSlots_) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+template <typename T, typename Allocator>
+void snapshot_vector<T, Allocator>::replace(std::unique_ptr<const vector_type> values)
+{
+    retired_.reserve(retired_.size() + 1);
+    std::unique_ptr<const vector_type> previous { current_.exchange(values.release(), std::memory_order_seq_cst) };
+    const auto retiredEpoch = epoch_.fetch_add(1, std::memory_order_seq_cst) + 1;
+    retired_.push_back({ std::move(previous), retiredEpoch });
+    reclaimRetired();
+}
+
+template <typename T, typename Allocator>
+typename snapshot_vector<T, Allocator>::size_type snapshot_vector<T, Allocator>::reclaimRetired()
+{
+    auto oldestEpoch = epoch_.load(std::memory_order_seq_cst);
+    for (size_type i = 0; i < numOfSlots_; ++i) {
+        const auto announced = slots_[i].epoch.load(std::memory_order_seq_cst);
+        if (announced != idleEpoch_) {
+            oldestEpoch = std::min(oldestEpoch, announced);
+        }
+    }
+    std::erase_if(retired_, [oldestEpoch](const retired_buffer& buffer) { return buffer.epoch <= oldestEpoch; });
+    return retired_.size();
+}
+}
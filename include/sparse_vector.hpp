@@ -0,0 +1,675 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "vector.hpp"
+
+namespace my_vec {
+/*
+* Vector over huge, sparsely populated index space. Indices are split into
+* pages of PageSize slots, pages hang in a radix tree of 64-way branches whose
+* height grows with the highest populated index. Every page and branch keeps
+* an occupancy bitmap and stores only its populated entries, compactly in index
+* order; entry is found at the popcount of occupancy bits below it. Memory thus
+* follows the number of populated entries, not the index space; on top of the
+* entries every populated page carries a PageSize / 8 byte bitmap, so large
+* PageSize is costly when entries are scattered.
+* Access is not O(1): it descends one branch per level, i.e. O(log64 of the
+* highest index) steps (4 below 2^30 with default PageSize, never more than
+* 10), plus PageSize / 64 popcounts inside the page. Flat page directory would
+* give O(1) access, but its memory grows with the index space.
+* Iteration visits populated entries in index order. Inserting or erasing
+* moves other elements of the same page, so references to them are
+* invalidated; iterators hold indices and stay valid while their entry is
+* populated.
+*
+* sparse_set is the classic dense/sparse set: sparse_vector maps index to
+* position in a dense vector of members, giving O(1) insert, erase (swap with
+* last member) and membership test, and contiguous iteration over members.
+*/
+
+namespace detail {
+    template <typename Container, typename Value>
+    class sparse_vector_iterator {
+    public:
+        using iterator_concept = std::forward_iterator_tag;
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = std::remove_cv_t<Value>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = Value*;
+        using reference = Value&;
+        using size_type = std::size_t;
+
+        sparse_vector_iterator() = default;
+        sparse_vector_iterator(Container* container, size_type index)
+            : container_ { container }
+            , index_ { index }
+        {
+        }
+        template <typename OtherContainer, typename OtherValue>
+            requires std::is_same_v<const OtherValue, Value>
+        sparse_vector_iterator(const sparse_vector_iterator<OtherContainer, OtherValue>& other)
+            : container_ { other.container_ }
+            , index_ { other.index_ }
+        {
+        }
+
+        // Index of the entry in sparse index space.
+        size_type index() const noexcept { return index_; }
+
+        reference operator*() const { return (*container_)[index_]; }
+        pointer operator->() const { return &**this; }
+
+        sparse_vector_iterator& operator++()
+        {
+            index_ = container_->findPopulated(index_ + 1);
+            return *this;
+        }
+        sparse_vector_iterator operator++(int)
+        {
+            auto copy = *this;
+            ++*this;
+            return copy;
+        }
+
+        friend bool operator==(const sparse_vector_iterator& lhs, const sparse_vector_iterator& rhs) { return lhs.index_ == rhs.index_; }
+
+    private:
+        template <typename, typename>
+        friend class sparse_vector_iterator;
+
+        Container* container_ = nullptr;
+        size_type index_ = std::numeric_limits<size_type>::max();
+    };
+}
+
+template <typename T, typename Allocator = my_alloc::allocator<T>, std::size_t PageSize = 64>
+class sparse_vector {
+    static_assert(PageSize >= 64 && std::has_single_bit(PageSize) && PageSize <= (std::size_t { 1 } << 31), "PageSize has to be power of two, at least 64");
+    static_assert(std::is_nothrow_move_constructible_v<T>, "sparse_vector relocates elements within pages, which must not throw");
+
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+    using reference = value_type&;
+    using const_reference = const value_type&;
+    using iterator = detail::sparse_vector_iterator<sparse_vector, T>;
+    using const_iterator = detail::sparse_vector_iterator<const sparse_vector, const T>;
+
+    constexpr static size_type pageSize = PageSize;
+
+    sparse_vector() noexcept(noexcept(Allocator())) = default;
+    explicit sparse_vector(const Allocator& alloc) noexcept;
+    sparse_vector(const sparse_vector& other);
+    sparse_vector& operator=(const sparse_vector& other);
+    sparse_vector(sparse_vector&& other) noexcept;
+    sparse_vector& operator=(sparse_vector&& other) noexcept;
+    ~sparse_vector() noexcept { clear(); }
+
+    allocator_type get_allocator() const noexcept { return alloc_; }
+
+    reference at(size_type index);
+    const_reference at(size_type index) const;
+    // Index has to be populated.
+    reference operator[](size_type index) { return getSlot(index); }
+    const_reference operator[](size_type index) const { return getSlot(index); }
+
+    iterator begin() noexcept { return iterator(this, findPopulated(0)); }
+    const_iterator begin() const noexcept { return const_iterator(this, findPopulated(0)); }
+    iterator end() noexcept { return iterator(this, end_); }
+    const_iterator end() const noexcept { return const_iterator(this, end_); }
+
+    [[nodiscard]] bool empty() const noexcept { return size_ == 0; }
+    // Number of populated entries.
+    size_type size() const noexcept { return size_; }
+    size_type allocated_pages() const noexcept { return allocatedPages_; }
+
+    bool contains(size_type index) const noexcept;
+    iterator find(size_type index) noexcept { return contains(index) ? iterator(this, index) : end(); }
+    const_iterator find(size_type index) const noexcept { return contains(index) ? const_iterator(this, index) : end(); }
+
+    void clear() noexcept;
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(size_type index, Args&&... args);
+    template <typename M>
+    std::pair<iterator, bool> insert_or_assign(size_type index, M&& obj);
+    size_type erase(size_type index);
+
+private:
+    template <typename, typename>
+    friend class detail::sparse_vector_iterator;
+
+    constexpr static size_type bitsPerWord_ = 64;
+    constexpr static size_type wordsPerPage_ = PageSize / bitsPerWord_;
+    constexpr static size_type pageBits_ = static_cast<size_type>(std::countr_zero(PageSize));
+    // Every branch has one occupancy word, so it fans out to 64 children.
+    constexpr static size_type fanoutBits_ = 6;
+    constexpr static size_type fanout_ = size_type { 1 } << fanoutBits_;
+    constexpr static size_type end_ = std::numeric_limits<size_type>::max();
+
+    struct page {
+        std::array<std::uint64_t, wordsPerPage_> occupied {};
+        std::uint32_t capacity = 0;
+        T* slots = nullptr;
+    };
+
+    struct branch {
+        std::uint64_t occupied = 0;
+        std::uint32_t capacity = 0;
+        // Array of pages at level 1, array of branches above.
+        void* children = nullptr;
+    };
+
+    [[no_unique_address]] Allocator alloc_ {};
+    branch root_ {};
+    size_type height_ = 1;
+    size_type size_ = 0;
+    size_type allocatedPages_ = 0;
+
+    constexpr static size_type getShift(size_type level) noexcept { return pageBits_ + fanoutBits_ * (level - 1); }
+    constexpr static size_type getDigit(size_type index, size_type level) noexcept { return (index >> getShift(level)) & (fanout_ - 1); }
+    constexpr static size_type getRank(std::uint64_t occupied, size_type bit) noexcept;
+    static size_type getSlotRank(const page& p, size_type slot) noexcept;
+    static size_type countOccupied(const page& p) noexcept;
+    static bool isOccupied(const page& p, size_type slot) noexcept { return (p.occupied[slot / bitsPerWord_] >> (slot % bitsPerWord_)) & 1U; }
+    bool isCovered(size_type index) const noexcept;
+
+    page* findPage(size_type index) const noexcept;
+    T& getSlot(size_type index) const noexcept;
+    size_type findPopulated(size_type from) const noexcept;
+    size_type findInBranch(const branch& b, size_type level, size_type from) const noexcept;
+    static size_type findInPage(const page& p, size_type from) noexcept;
+
+    void growToCover(size_type index);
+    T& insertIntoBranch(branch& b, size_type level, size_type index, T& value);
+    T& insertIntoPage(page& p, size_type slot, T& value);
+    void eraseFromBranch(branch& b, size_type level, size_type index) noexcept;
+    void destroyBranch(branch& b, size_type level) noexcept;
+
+    template <typename U>
+    auto getAllocator() const noexcept { return typename std::allocator_traits<Allocator>::template rebind_alloc<U>(alloc_); }
+    template <typename U>
+    U* insertCompact(U* data, std::uint32_t& capacity, size_type count, size_type rank, U&& value, size_type maxCapacity);
+    template <typename U>
+    U* eraseCompact(U* data, std::uint32_t& capacity, size_type count, size_type rank) noexcept;
+};
+
+template <typename T, typename Allocator, std::size_t PageSize>
+sparse_vector<T, Allocator, PageSize>::sparse_vector(const Allocator& alloc) noexcept
+    : alloc_ { alloc }
+{
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+sparse_vector<T, Allocator, PageSize>::sparse_vector(const sparse_vector& other)
+    : alloc_ { other.alloc_ }
+{
+    try {
+        for (auto it = other.begin(); it != other.end(); ++it) {
+            try_emplace(it.index(), *it);
+        }
+    } catch (...) {
+        clear();
+        throw;
+    }
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+sparse_vector<T, Allocator, PageSize>& sparse_vector<T, Allocator, PageSize>::operator=(const sparse_vector& other)
+{
+    if (this != &other) {
+        sparse_vector copy { other };
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+sparse_vector<T, Allocator, PageSize>::sparse_vector(sparse_vector&& other) noexcept
+    : alloc_ { other.alloc_ }
+    , root_ { std::exchange(other.root_, {}) }
+    , height_ { std::exchange(other.height_, 1) }
+    , size_ { std::exchange(other.size_, 0) }
+    , allocatedPages_ { std::exchange(other.allocatedPages_, 0) }
+{
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+sparse_vector<T, Allocator, PageSize>& sparse_vector<T, Allocator, PageSize>::operator=(sparse_vector&& other) noexcept
+{
+    if (this != &other) {
+        clear();
+        alloc_ = other.alloc_;
+        root_ = std::exchange(other.root_, {});
+        height_ = std::exchange(other.height_, 1);
+        size_ = std::exchange(other.size_, 0);
+        allocatedPages_ = std::exchange(other.allocatedPages_, 0);
+    }
+    return *this;
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+typename sparse_vector<T, Allocator, PageSize>::reference sparse_vector<T, Allocator, PageSize>::at(size_type index)
+{
+    if (!contains(index)) {
+        throw std::out_of_range { "Position not populated in sparse_vector" };
+    }
+    return (*this)[index];
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+typename sparse_vector<T, Allocator, PageSize>::const_reference sparse_vector<T, Allocator, PageSize>::at(size_type index) const
+{
+    if (!contains(index)) {
+        throw std::out_of_range { "Position not populated in sparse_vector" };
+    }
+    return (*this)[index];
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+bool sparse_vector<T, Allocator, PageSize>::contains(size_type index) const noexcept
+{
+    const page* p = findPage(index);
+    return p != nullptr && isOccupied(*p, index % PageSize);
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+void sparse_vector<T, Allocator, PageSize>::clear() noexcept
+{
+    destroyBranch(root_, height_);
+    root_ = {};
+    height_ = 1;
+    size_ = 0;
+    allocatedPages_ = 0;
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+template <typename... Args>
+std::pair<typename sparse_vector<T, Allocator, PageSize>::iterator, bool> sparse_vector<T, Allocator, PageSize>::try_emplace(size_type index, Args&&... args)
+{
+    if (contains(index)) {
+        return { iterator(this, index), false };
+    }
+    // Element is built before the tree changes, so throwing constructor leaves nothing to undo.
+    T value(std::forward<Args>(args)...);
+    growToCover(index);
+    insertIntoBranch(root_, height_, index, value);
+    ++size_;
+    return { iterator(this, index), true };
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+template <typename M>
+std::pair<typename sparse_vector<T, Allocator, PageSize>::iterator, bool> sparse_vector<T, Allocator, PageSize>::insert_or_assign(size_type index, M&& obj)
+{
+    auto result = try_emplace(index, std::forward<M>(obj));
+    if (!result.second) {
+        *result.first = std::forward<M>(obj);
+    }
+    return result;
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+typename sparse_vector<T, Allocator, PageSize>::size_type sparse_vector<T, Allocator, PageSize>::erase(size_type index)
+{
+    if (!contains(index)) {
+        return 0;
+    }
+    eraseFromBranch(root_, height_, index);
+    if (--size_ == 0) {
+        height_ = 1;
+    }
+    return 1;
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+constexpr typename sparse_vector<T, Allocator, PageSize>::size_type sparse_vector<T, Allocator, PageSize>::getRank(std::uint64_t occupied, size_type bit) noexcept
+{
+    return static_cast<size_type>(std::popcount(occupied & ((std::uint64_t { 1 } << bit) - 1)));
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+typename sparse_vector<T, Allocator, PageSize>::size_type sparse_vector<T, Allocator, PageSize>::getSlotRank(const page& p, size_type slot) noexcept
+{
+    size_type rank = 0;
+    for (size_type word = 0; word < slot / bitsPerWord_; ++word) {
+        rank += static_cast<size_type>(std::popcount(p.occupied[word]));
+    }
+    return rank + getRank(p.occupied[slot / bitsPerWord_], slot % bitsPerWord_);
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+typename sparse_vector<T, Allocator, PageSize>::size_type sparse_vector<T, Allocator, PageSize>::countOccupied(const page& p) noexcept
+{
+    size_type count = 0;
+    for (const auto word : p.occupied) {
+        count += static_cast<size_type>(std::popcount(word));
+    }
+    return count;
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+bool sparse_vector<T, Allocator, PageSize>::isCovered(size_type index) const noexcept
+{
+    const auto bits = pageBits_ + fanoutBits_ * height_;
+    return bits >= bitsPerWord_ || (index >> bits) == 0;
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+typename sparse_vector<T, Allocator, PageSize>::page* sparse_vector<T, Allocator, PageSize>::findPage(size_type index) const noexcept
+{
+    if (!isCovered(index)) {
+        return nullptr;
+    }
+    const branch* b = &root_;
+    for (auto level = height_;; --level) {
+        const auto digit = getDigit(index, level);
+        if (((b->occupied >> digit) & 1U) == 0) {
+            return nullptr;
+        }
+        const auto rank = getRank(b->occupied, digit);
+        if (level == 1) {
+            return static_cast<page*>(b->children) + rank;
+        }
+        b = static_cast<const branch*>(b->children) + rank;
+    }
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+T& sparse_vector<T, Allocator, PageSize>::getSlot(size_type index) const noexcept
+{
+    page* p = findPage(index);
+    return p->slots[getSlotRank(*p, index % PageSize)];
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+typename sparse_vector<T, Allocator, PageSize>::size_type sparse_vector<T, Allocator, PageSize>::findPopulated(size_type from) const noexcept
+{
+    if (size_ == 0 || !isCovered(from)) {
+        return end_;
+    }
+    return findInBranch(root_, height_, from);
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+typename sparse_vector<T, Allocator, PageSize>::size_type sparse_vector<T, Allocator, PageSize>::findInBranch(const branch& b, size_type level, size_type from) const noexcept
+{
+    const auto shift = getShift(level);
+    const auto digit = getDigit(from, level);
+    const auto above = shift + fanoutBits_ >= bitsPerWord_ ? 0 : (from >> (shift + fanoutBits_)) << (shift + fanoutBits_);
+    // Subtrees are never empty, so only the subtree holding from itself may have nothing at or after it.
+    for (auto bits = b.occupied & (~std::uint64_t { 0 } << digit); bits != 0; bits &= bits - 1) {
+        const auto child = static_cast<size_type>(std::countr_zero(bits));
+        const auto rank = getRank(b.occupied, child);
+        const auto childFrom = child == digit ? from : above | (child << shift);
+        const auto result = level == 1 ? findInPage(static_cast<const page*>(b.children)[rank], childFrom)
+                                       : findInBranch(static_cast<const branch*>(b.children)[rank], level - 1, childFrom);
+        if (result != end_) {
+            return result;
+        }
+    }
+    return end_;
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+typename sparse_vector<T, Allocator, PageSize>::size_type sparse_vector<T, Allocator, PageSize>::findInPage(const page& p, size_type from) noexcept
+{
+    const auto firstSlot = from % PageSize;
+    for (auto word = firstSlot / bitsPerWord_; word < wordsPerPage_; ++word) {
+        auto bits = p.occupied[word];
+        if (word == firstSlot / bitsPerWord_) {
+            bits &= ~std::uint64_t { 0 } << (firstSlot % bitsPerWord_);
+        }
+        if (bits != 0) {
+            return from - firstSlot + word * bitsPerWord_ + static_cast<size_type>(std::countr_zero(bits));
+        }
+    }
+    return end_;
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+void sparse_vector<T, Allocator, PageSize>::growToCover(size_type index)
+{
+    while (!isCovered(index)) {
+        if (root_.occupied != 0) {
+            auto alloc = getAllocator<branch>();
+            branch* children = alloc.allocate(1);
+            std::construct_at(children, root_);
+            root_ = branch { 1, 1, children };
+        }
+        ++height_;
+    }
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+T& sparse_vector<T, Allocator, PageSize>::insertIntoBranch(branch& b, size_type level, size_type index, T& value)
+{
+    const auto digit = getDigit(index, level);
+    const auto rank = getRank(b.occupied, digit);
+    const bool created = ((b.occupied >> digit) & 1U) == 0;
+    const auto count = static_cast<size_type>(std::popcount(b.occupied));
+    if (created) {
+        if (level == 1) {
+            b.children = insertCompact(static_cast<page*>(b.children), b.capacity, count, rank, page {}, fanout_);
+            ++allocatedPages_;
+        } else {
+            b.children = insertCompact(static_cast<branch*>(b.children), b.capacity, count, rank, branch {}, fanout_);
+        }
+        b.occupied |= std::uint64_t { 1 } << digit;
+    }
+    try {
+        if (level == 1) {
+            return insertIntoPage(static_cast<page*>(b.children)[rank], index % PageSize, value);
+        }
+        return insertIntoBranch(static_cast<branch*>(b.children)[rank], level - 1, index, value);
+    } catch (...) {
+        // Child created above is still empty and must not stay in the tree.
+        if (created) {
+            if (level == 1) {
+                b.children = eraseCompact(static_cast<page*>(b.children), b.capacity, count + 1, rank);
+                --allocatedPages_;
+            } else {
+                b.children = eraseCompact(static_cast<branch*>(b.children), b.capacity, count + 1, rank);
+            }
+            b.occupied &= ~(std::uint64_t { 1 } << digit);
+        }
+        throw;
+    }
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+T& sparse_vector<T, Allocator, PageSize>::insertIntoPage(page& p, size_type slot, T& value)
+{
+    const auto rank = getSlotRank(p, slot);
+    p.slots = insertCompact(p.slots, p.capacity, countOccupied(p), rank, std::move(value), PageSize);
+    p.occupied[slot / bitsPerWord_] |= std::uint64_t { 1 } << (slot % bitsPerWord_);
+    return p.slots[rank];
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+void sparse_vector<T, Allocator, PageSize>::eraseFromBranch(branch& b, size_type level, size_type index) noexcept
+{
+    const auto digit = getDigit(index, level);
+    const auto rank = getRank(b.occupied, digit);
+    const auto count = static_cast<size_type>(std::popcount(b.occupied));
+    if (level == 1) {
+        auto& p = static_cast<page*>(b.children)[rank];
+        const auto slot = index % PageSize;
+        p.slots = eraseCompact(p.slots, p.capacity, countOccupied(p), getSlotRank(p, slot));
+        p.occupied[slot / bitsPerWord_] &= ~(std::uint64_t { 1 } << (slot % bitsPerWord_));
+        if (p.slots != nullptr) {
+            return;
+        }
+        b.children = eraseCompact(static_cast<page*>(b.children), b.capacity, count, rank);
+        --allocatedPages_;
+    } else {
+        auto& child = static_cast<branch*>(b.children)[rank];
+        eraseFromBranch(child, level - 1, index);
+        if (child.occupied != 0) {
+            return;
+        }
+        b.children = eraseCompact(static_cast<branch*>(b.children), b.capacity, count, rank);
+    }
+    b.occupied &= ~(std::uint64_t { 1 } << digit);
+}
+
+template <typename T, typename Allocator, std::size_t PageSize>
+void sparse_vector<T, Allocator, PageSize>::destroyBranch(branch& b, size_type level) noexcept
+{
+    const auto count = static_cast<size_type>(std::popcount(b.occupied));
+    if (level == 1) {
+        auto* pages = static_cast<page*>(b.children);
+        auto slotAlloc = getAllocator<T>();
+        for (size_type i = 0; i < count; ++i) {
+            std::destroy_n(pages[i].slots, countOccupied(pages[i]));
+            slotAlloc.deallocate(pages[i].slots, pages[i].capacity);
+        }
+        getAllocator<page>().deallocate(pages, b.capacity);
+    } else {
+        auto* branches = static_cast<branch*>(b.children);
+        for (size_type i = 0; i < count; ++i) {
+            destroyBranch(branches[i], level - 1);
+        }
+        getAllocator<branch>().deallocate(branches, b.capacity);
+    }
+}
+
+// Inserts value at rank of compact array holding count elements, growing it geometrically up to maxCapacity.
+template <typename T, typename Allocator, std::size_t PageSize>
+template <typename U>
+U* sparse_vector<T, Allocator, PageSize>::insertCompact(U* data, std::uint32_t& capacity, size_type count, size_type rank, U&& value, size_type maxCapacity)
+{
+    if (count < capacity) {
+        for (auto i = count; i > rank; --i) {
+            std::construct_at(data + i, std::move(data[i - 1]));
+            std::destroy_at(data + i - 1);
+        }
+        std::construct_at(data + rank, std::move(value));
+        return data;
+    }
+
+    auto alloc = getAllocator<U>();
+    const auto newCapacity = std::min(std::max<size_type>(1, 2 * size_type { capacity }), maxCapacity);
+    U* newData = alloc.allocate(newCapacity);
+    std::construct_at(newData + rank, std::move(value));
+    std::uninitialized_move(data, data + rank, newData);
+    std::uninitialized_move(data + rank, data + count, newData + rank + 1);
+    std::destroy(data, data + count);
+    if (data != nullptr) {
+        alloc.deallocate(data, capacity);
+    }
+    capacity = static_cast<std::uint32_t>(newCapacity);
+    return newData;
+}
+
+// Removes element at rank, array is freed when it gets empty and shrunk when it is three quarters unused.
+template <typename T, typename Allocator, std::size_t PageSize>
+template <typename U>
+U* sparse_vector<T, Allocator, PageSize>::eraseCompact(U* data, std::uint32_t& capacity, size_type count, size_type rank) noexcept
+{
+    auto alloc = getAllocator<U>();
+    std::destroy_at(data + rank);
+    for (auto i = rank + 1; i < count; ++i) {
+        std::construct_at(data + i - 1, std::move(data[i]));
+        std::destroy_at(data + i);
+    }
+
+    const auto newCount = count - 1;
+    if (newCount == 0) {
+        alloc.deallocate(data, capacity);
+        capacity = 0;
+        return nullptr;
+    }
+    if (4 * newCount <= capacity) {
+        // Shrinking only gives memory back, if smaller block cannot be allocated current one is kept.
+        try {
+            U* newData = alloc.allocate(2 * newCount);
+            std::uninitialized_move(data, data + newCount, newData);
+            std::destroy(data, data + newCount);
+            alloc.deallocate(data, capacity);
+            capacity = static_cast<std::uint32_t>(2 * newCount);
+            return newData;
+        } catch (...) {
+        }
+    }
+    return data;
+}
+
+template <std::size_t PageSize = 64>
+class sparse_set {
+public:
+    using value_type = std::size_t;
+    using size_type = std::size_t;
+    using const_iterator = const value_type*;
+    using iterator = const_iterator;
+
+    const_iterator begin() const noexcept { return members_.begin(); }
+    const_iterator end() const noexcept { return members_.end(); }
+    const value_type* data() const noexcept { return members_.data(); }
+
+    [[nodiscard]] bool empty() const noexcept { return members_.empty(); }
+    size_type size() const noexcept { return members_.size(); }
+
+    bool contains(value_type index) const noexcept { return positions_.contains(index); }
+    // Position of member in dense order, index has to be a member.
+    size_type position_of(value_type index) const noexcept { return positions_[index]; }
+
+    void clear() noexcept;
+    // Returns whether index was inserted, i.e. was not a member yet.
+    bool insert(value_type index);
+    // Returns whether index was erased, last member takes its dense position.
+    bool erase(value_type index);
+
+private:
+    vector<value_type> members_;
+    sparse_vector<size_type, my_alloc::allocator<size_type>, PageSize> positions_;
+};
+
+template <std::size_t PageSize>
+void sparse_set<PageSize>::clear() noexcept
+{
+    members_.clear();
+    positions_.clear();
+}
+
+template <std::size_t PageSize>
+bool sparse_set<PageSize>::insert(value_type index)
+{
+    if (!positions_.try_emplace(index, members_.size()).second) {
+        return false;
+    }
+    try {
+        members_.push_back(index);
+    } catch (...) {
+        positions_.erase(index);
+        throw;
+    }
+    return true;
+}
+
+template <std::size_t PageSize>
+bool sparse_set<PageSize>::erase(value_type index)
+{
+    if (!contains(index)) {
+        return false;
+    }
+    const auto position = positions_[index];
+    const auto last = members_.back();
+    members_[position] = last;
+    positions_[last] = position;
+    members_.pop_back();
+    positions_.erase(index);
+    return true;
+}
+}
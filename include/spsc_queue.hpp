@@ -0,0 +1,203 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <utility>
+
+#include "allocator.hpp"
+
+namespace my_vec {
+/*
+* Bounded wait-free queue for exactly one producer thread and one consumer
+* thread. Slots form a power-of-two ring taken from allocator with one cache
+* line of padding on both sides, so neighbouring allocations never share a
+* line with elements. Producer owns tail index and consumer owns head index,
+* each on its own cache line next to a cached copy of the opposite index:
+* the opposite index is reloaded only when cached one cannot satisfy the
+* request, i.e. shows fewer free slots (producer) or queued elements (consumer)
+* than the operation asks for, so in steady state the two threads do not
+* bounce lines between cores. Batch operations publish index once per batch.
+*/
+
+template <typename T, typename Allocator = my_alloc::allocator<T>>
+class spsc_queue {
+public:
+    using value_type = T;
+    using allocator_type = Allocator;
+    using size_type = std::size_t;
+
+    constexpr static size_type cacheLineSize = 64;
+
+    explicit spsc_queue(size_type capacity, const Allocator& alloc = Allocator());
+    spsc_queue(const spsc_queue&) = delete;
+    spsc_queue& operator=(const spsc_queue&) = delete;
+    ~spsc_queue() noexcept;
+
+    size_type capacity() const noexcept { return capacity_; }
+    // Exact only when called from producer or consumer while the other one is idle.
+    size_type size() const noexcept;
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    // Producer side, every operation returns without waiting when queue is full.
+    template <typename... Args>
+    bool try_emplace(Args&&... args);
+    bool try_push(const T& value) { return try_emplace(value); }
+    bool try_push(T&& value) { return try_emplace(std::move(value)); }
+    // Copies longest prefix of values which fits, returns its length.
+    size_type try_push(std::span<const T> values);
+
+    // Consumer side, every operation returns without waiting when queue is empty.
+    T* front() noexcept;
+    void pop() noexcept;
+    bool try_pop(T& value);
+    // Moves up to values.size() oldest elements into values, returns their number.
+    size_type try_pop(std::span<T> values);
+
+private:
+    constexpr static size_type padding_ = (cacheLineSize + sizeof(T) - 1) / sizeof(T);
+
+    [[no_unique_address]] Allocator alloc_;
+    size_type capacity_;
+    T* slots_;
+
+    alignas(cacheLineSize) std::atomic<size_type> tail_ { 0 };
+    size_type cachedHead_ { 0 };
+
+    alignas(cacheLineSize) std::atomic<size_type> head_ { 0 };
+    size_type cachedTail_ { 0 };
+
+    T* getSlot(size_type index) const noexcept { return slots_ + (index & (capacity_ - 1)); }
+    // Cached index of the other side is reloaded only when it cannot satisfy request.
+    size_type getFreeSlots(size_type tail, size_type requested);
+    size_type getUsedSlots(size_type head, size_type requested);
+};
+
+template <typename T, typename Allocator>
+spsc_queue<T, Allocator>::spsc_queue(size_type capacity, const Allocator& alloc)
+    : alloc_ { alloc }
+    , capacity_ { std::bit_ceil(std::max<size_type>(capacity, 1)) }
+    , slots_ { alloc_.allocate(capacity_ + 2 * padding_) + padding_ }
+{
+}
+
+template <typename T, typename Allocator>
+spsc_queue<T, Allocator>::~spsc_queue() noexcept
+{
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    for (auto head = head_.load(std::memory_order_relaxed); head != tail; ++head) {
+        std::destroy_at(getSlot(head));
+    }
+    alloc_.deallocate(slots_ - padding_, capacity_ + 2 * padding_);
+}
+
+template <typename T, typename Allocator>
+typename spsc_queue<T, Allocator>::size_type spsc_queue<T, Allocator>::size() const noexcept
+{
+    const auto head = head_.load(std::memory_order_acquire);
+    const auto tail = tail_.load(std::memory_order_acquire);
+    return tail - head;
+}
+
+template <typename T, typename Allocator>
+template <typename... Args>
+bool spsc_queue<T, Allocator>::try_emplace(Args&&... args)
+{
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    if (getFreeSlots(tail, 1) == 0) {
+        return false;
+    }
+    std::construct_at(getSlot(tail), std::forward<Args>(args)...);
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+template <typename T, typename Allocator>
+typename spsc_queue<T, Allocator>::size_type spsc_queue<T, Allocator>::try_push(std::span<const T> values)
+{
+    const auto tail = tail_.load(std::memory_order_relaxed);
+    const auto count = std::min(values.size(), getFreeSlots(tail, values.size()));
+    // Batch occupies end of ring and possibly wraps to its start.
+    const auto firstSize = std::min(count, capacity_ - (tail & (capacity_ - 1)));
+    T* first = getSlot(tail);
+    std::uninitialized_copy(values.begin(), values.begin() + static_cast<std::ptrdiff_t>(firstSize), first);
+    try {
+        std::uninitialized_copy(values.begin() + static_cast<std::ptrdiff_t>(firstSize), values.begin() + static_cast<std::ptrdiff_t>(count), slots_);
+    } catch (...) {
+        std::destroy(first, first + firstSize);
+        throw;
+    }
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+template <typename T, typename Allocator>
+T* spsc_queue<T, Allocator>::front() noexcept
+{
+    const auto head = head_.load(std::memory_order_relaxed);
+    return getUsedSlots(head, 1) == 0 ? nullptr : getSlot(head);
+}
+
+// Queue must not be empty, i.e. front() has returned element.
+template <typename T, typename Allocator>
+void spsc_queue<T, Allocator>::pop() noexcept
+{
+    const auto head = head_.load(std::memory_order_relaxed);
+    std::destroy_at(getSlot(head));
+    head_.store(head + 1, std::memory_order_release);
+}
+
+template <typename T, typename Allocator>
+bool spsc_queue<T, Allocator>::try_pop(T& value)
+{
+    T* element = front();
+    if (element == nullptr) {
+        return false;
+    }
+    value = std::move(*element);
+    pop();
+    return true;
+}
+
+template <typename T, typename Allocator>
+typename spsc_queue<T, Allocator>::size_type spsc_queue<T, Allocator>::try_pop(std::span<T> values)
+{
+    const auto head = head_.load(std::memory_order_relaxed);
+    const auto count = std::min(values.size(), getUsedSlots(head, values.size()));
+    size_type moved = 0;
+    try {
+        for (; moved < count; ++moved) {
+            T* element = getSlot(head + moved);
+            values[moved] = std::move(*element);
+            std::destroy_at(element);
+        }
+    } catch (...) {
+        // Elements already handed out leave queue, the one which failed to move stays at front.
+        head_.store(head + moved, std::memory_order_release);
+        throw;
+    }
+    head_.store(head + count, std::memory_order_release);
+    return count;
+}
+
+template <typename T, typename Allocator>
+typename spsc_queue<T, Allocator>::size_type spsc_queue<T, Allocator>::getFreeSlots(size_type tail, size_type requested)
+{
+    if (capacity_ - (tail - cachedHead_) < requested) {
+        cachedHead_ = head_.load(std::memory_order_acquire);
+    }
+    return capacity_ - (tail - cachedHead_);
+}
+
+template <typename T, typename Allocator>
+typename spsc_queue<T, Allocator>::size_type spsc_queue<T, Allocator>::getUsedSlots(size_type head, size_type requested)
+{
+    if (cachedTail_ - head < requested) {
+        cachedTail_ = tail_.load(std::memory_order_acquire);
+    }
+    return cachedTail_ - head;
+}
+}
@@ -0,0 +1,227 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace my_vec {
+/*
+* Small work-stealing thread pool used by parallel bulk operations.
+* Every worker owns a task queue, it takes work from the back of its own
+* queue and steals from the front of other queues when it runs dry.
+* Ranges shorter than sequential_threshold() are processed by the calling thread.
+*/
+
+class thread_pool {
+public:
+    using size_type = std::size_t;
+
+    constexpr static size_type defaultSequentialThreshold = 1 << 16;
+
+    explicit thread_pool(size_type numOfThreads = std::thread::hardware_concurrency(),
+        size_type sequentialThreshold = defaultSequentialThreshold);
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+    ~thread_pool() noexcept;
+
+    size_type size() const noexcept { return workers_.size(); }
+    size_type sequential_threshold() const noexcept { return sequentialThreshold_.load(std::memory_order_relaxed); }
+    void set_sequential_threshold(size_type threshold) noexcept { sequentialThreshold_.store(threshold, std::memory_order_relaxed); }
+
+    template <typename Fn>
+    void submit(Fn&& task);
+    template <typename Fn>
+    void parallel_for(size_type first, size_type last, Fn&& fn);
+    template <typename Fn>
+    void parallel_for(size_type first, size_type last, size_type numOfChunks, Fn&& fn);
+
+    static thread_pool& instance();
+
+private:
+    struct worker_queue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    std::vector<std::unique_ptr<worker_queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::atomic<size_type> sequentialThreshold_;
+    std::atomic<size_type> pending_ { 0 };
+    std::atomic<size_type> nextQueue_ { 0 };
+    std::mutex sleepMutex_;
+    std::condition_variable sleepCondition_;
+    bool stop_ { false };
+
+    inline static thread_local const thread_pool* currentPool_ = nullptr;
+    inline static thread_local size_type currentWorker_ = 0;
+
+    void workerLoop(size_type index);
+    bool tryRunTask(size_type startQueue);
+};
+
+inline thread_pool::thread_pool(size_type numOfThreads, size_type sequentialThreshold)
+    : sequentialThreshold_ { sequentialThreshold }
+{
+    queues_.reserve(numOfThreads);
+    for (size_type i = 0; i < numOfThreads; ++i) {
+        queues_.push_back(std::make_unique<worker_queue>());
+    }
+    workers_.reserve(numOfThreads);
+    for (size_type i = 0; i < numOfThreads; ++i) {
+        workers_.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+inline thread_pool::~thread_pool() noexcept
+{
+    {
+        std::lock_guard lock { sleepMutex_ };
+        stop_ = true;
+    }
+    sleepCondition_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+}
+
+template <typename Fn>
+void thread_pool::submit(Fn&& task)
+{
+    if (queues_.empty()) {
+        task();
+        return;
+    }
+
+    const auto queue = currentPool_ == this ? currentWorker_ : nextQueue_.fetch_add(1, std::memory_order_relaxed) % queues_.size();
+    pending_.fetch_add(1, std::memory_order_release);
+    {
+        std::lock_guard lock { queues_[queue]->mutex };
+        queues_[queue]->tasks.emplace_back(std::forward<Fn>(task));
+    }
+    {
+        std::lock_guard lock { sleepMutex_ };
+    }
+    sleepCondition_.notify_one();
+}
+
+template <typename Fn>
+void thread_pool::parallel_for(size_type first, size_type last, Fn&& fn)
+{
+    parallel_for(first, last, 4 * (size() + 1), std::forward<Fn>(fn));
+}
+
+template <typename Fn>
+void thread_pool::parallel_for(size_type first, size_type last, size_type numOfChunks, Fn&& fn)
+{
+    const auto count = last - first;
+    if (count == 0) {
+        return;
+    }
+    if (count < sequential_threshold() || size() == 0 || numOfChunks < 2) {
+        fn(first, last);
+        return;
+    }
+
+    numOfChunks = std::min(numOfChunks, count);
+    const auto chunkSize = count / numOfChunks;
+    const auto remainder = count % numOfChunks;
+
+    std::atomic<size_type> remaining { numOfChunks };
+    std::mutex errorMutex;
+    std::exception_ptr error;
+
+    auto runChunk = [&](size_type begin, size_type end) {
+        try {
+            fn(begin, end);
+        } catch (...) {
+            std::lock_guard lock { errorMutex };
+            if (!error) {
+                error = std::current_exception();
+            }
+        }
+        remaining.fetch_sub(1, std::memory_order_acq_rel);
+    };
+
+    // The calling thread keeps the first chunk and helps with queued tasks while waiting,
+    // so nested parallel_for calls issued from workers cannot deadlock the pool.
+    size_type begin = first + chunkSize + (remainder > 0 ? 1 : 0);
+    for (size_type chunk = 1; chunk < numOfChunks; ++chunk) {
+        const auto end = begin + chunkSize + (chunk < remainder ? 1 : 0);
+        submit([&runChunk, begin, end] { runChunk(begin, end); });
+        begin = end;
+    }
+    runChunk(first, first + chunkSize + (remainder > 0 ? 1 : 0));
+
+    while (remaining.load(std::memory_order_acquire) != 0) {
+        if (!tryRunTask(currentPool_ == this ? currentWorker_ : 0)) {
+            std::this_thread::yield();
+        }
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+inline thread_pool& thread_pool::instance()
+{
+    static thread_pool pool;
+    return pool;
+}
+
+inline void thread_pool::workerLoop(size_type index)
+{
+    currentPool_ = this;
+    currentWorker_ = index;
+    while (true) {
+        if (tryRunTask(index)) {
+            continue;
+        }
+        std::unique_lock lock { sleepMutex_ };
+        sleepCondition_.wait(lock, [this] { return stop_ || pending_.load(std::memory_order_acquire) != 0; });
+        if (stop_ && pending_.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+inline bool thread_pool::tryRunTask(size_type startQueue)
+{
+    if (pending_.load(std::memory_order_acquire) == 0) {
+        return false;
+    }
+
+    std::function<void()> task;
+    for (size_type i = 0; i < queues_.size() && !task; ++i) {
+        const auto queue = (startQueue + i) % queues_.size();
+        std::lock_guard lock { queues_[queue]->mutex };
+        auto& tasks = queues_[queue]->tasks;
+        if (tasks.empty()) {
+            continue;
+        }
+        if (i == 0) {
+            task = std::move(tasks.back());
+            tasks.pop_back();
+        } else {
+            task = std::move(tasks.front());
+            tasks.pop_front();
+        }
+    }
+    if (!task) {
+        return false;
+    }
+
+    pending_.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    return true;
+}
+}
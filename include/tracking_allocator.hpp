@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <vector>
+
+#include "allocator.hpp"
+
+namespace my_alloc {
+/*
+* Allocator adapter which forwards to Inner allocator and records every
+* allocation in process-wide tracking_registry: log2 histogram of block sizes,
+* allocation latency, live bytes and their high-water mark.
+* Event counters are kept per thread and written only by owning thread, so
+* allocation path does not share cache lines with other threads except for
+* live bytes counter which has to be global to give exact high-water mark.
+*/
+
+struct tracking_snapshot {
+    constexpr static std::size_t numOfBuckets = 65;
+
+    std::uint64_t allocations = 0;
+    std::uint64_t deallocations = 0;
+    std::uint64_t allocatedBytes = 0;
+    std::uint64_t deallocatedBytes = 0;
+    std::int64_t liveBytes = 0;
+    std::int64_t highWaterBytes = 0;
+    std::uint64_t totalLatencyNs = 0;
+    std::uint64_t maxLatencyNs = 0;
+    // Bucket i counts blocks of size in [2^(i-1), 2^i), bucket 0 counts empty blocks.
+    std::array<std::uint64_t, numOfBuckets> sizeHistogram {};
+};
+
+class tracking_registry {
+public:
+    static tracking_registry& instance();
+
+    void on_allocate(std::size_t bytes, std::uint64_t latencyNs);
+    void on_deallocate(std::size_t bytes);
+
+    tracking_snapshot snapshot() const;
+    void reset();
+    void dump_text(std::ostream& out) const;
+    void dump_json(std::ostream& out) const;
+
+private:
+    struct thread_counters {
+        std::atomic<std::uint64_t> allocations { 0 };
+        std::atomic<std::uint64_t> deallocations { 0 };
+        std::atomic<std::uint64_t> allocatedBytes { 0 };
+        std::atomic<std::uint64_t> deallocatedBytes { 0 };
+        std::atomic<std::uint64_t> totalLatencyNs { 0 };
+        std::atomic<std::uint64_t> maxLatencyNs { 0 };
+        std::array<std::atomic<std::uint64_t>, tracking_snapshot::numOfBuckets> sizeHistogram {};
+    };
+
+    mutable std::mutex threadsMutex_;
+    std::vector<std::shared_ptr<thread_counters>> threads_;
+    std::atomic<std::int64_t> liveBytes_ { 0 };
+    std::atomic<std::int64_t> highWaterBytes_ { 0 };
+
+    thread_counters& getLocalCounters();
+    static void increment(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept;
+};
+
+template <typename Inner>
+struct tracking_allocator {
+    using value_type = typename Inner::value_type;
+    using size_type = std::size_t;
+
+    // Value type comes from Inner, so rebinding has to go through Inner as well.
+    template <typename U>
+    struct rebind {
+        using other = tracking_allocator<typename std::allocator_traits<Inner>::template rebind_alloc<U>>;
+    };
+
+    constexpr tracking_allocator() noexcept(noexcept(Inner())) = default;
+    constexpr explicit tracking_allocator(const Inner& inner)
+        : inner_ { inner }
+    {
+    }
+    constexpr tracking_allocator(const tracking_allocator& other) = default;
+    template <typename OtherInner>
+    constexpr tracking_allocator(const tracking_allocator<OtherInner>& other)
+        : inner_(other.inner())
+    {
+    }
+    constexpr tracking_allocator& operator=(const tracking_allocator& other) = default;
+    constexpr ~tracking_allocator() = default;
+
+    [[nodiscard]] value_type* allocate(size_type n);
+    void deallocate(value_type* p, size_type n);
+
+    constexpr const Inner& inner() const noexcept { return inner_; }
+
+private:
+    [[no_unique_address]] Inner inner_ {};
+};
+
+inline tracking_registry& tracking_registry::instance()
+{
+    static tracking_registry registry;
+    return registry;
+}
+
+inline void tracking_registry::on_allocate(std::size_t bytes, std::uint64_t latencyNs)
+{
+    auto& counters = getLocalCounters();
+    increment(counters.allocations, 1);
+    increment(counters.allocatedBytes, bytes);
+    increment(counters.totalLatencyNs, latencyNs);
+    if (latencyNs > counters.maxLatencyNs.load(std::memory_order_relaxed)) {
+        counters.maxLatencyNs.store(latencyNs, std::memory_order_relaxed);
+    }
+    increment(counters.sizeHistogram[static_cast<std::size_t>(std::bit_width(bytes))], 1);
+
+    const auto live = liveBytes_.fetch_add(static_cast<std::int64_t>(bytes), std::memory_order_relaxed) + static_cast<std::int64_t>(bytes);
+    auto highWater = highWaterBytes_.load(std::memory_order_relaxed);
+    while (live > highWater && !highWaterBytes_.compare_exchange_weak(highWater, live, std::memory_order_relaxed)) {
+    }
+}
+
+inline void tracking_registry::on_deallocate(std::size_t bytes)
+{
+    auto& counters = getLocalCounters();
+    increment(counters.deallocations, 1);
+    increment(counters.deallocatedBytes, bytes);
+    liveBytes_.fetch_sub(static_cast<std::int64_t>(bytes), std::memory_order_relaxed);
+}
+
+inline tracking_snapshot tracking_registry::snapshot() const
+{
+    tracking_snapshot result;
+    std::lock_guard lock { threadsMutex_ };
+    for (const auto& counters : threads_) {
+        result.allocations += counters->allocations.load(std::memory_order_relaxed);
+        result.deallocations += counters->deallocations.load(std::memory_order_relaxed);
+        result.allocatedBytes += counters->allocatedBytes.load(std::memory_order_relaxed);
+        result.deallocatedBytes += counters->deallocatedBytes.load(std::memory_order_relaxed);
+        result.totalLatencyNs += counters->totalLatencyNs.load(std::memory_order_relaxed);
+        result.maxLatencyNs = std::max(result.maxLatencyNs, counters->maxLatencyNs.load(std::memory_order_relaxed));
+        for (std::size_t i = 0; i < tracking_snapshot::numOfBuckets; ++i) {
+            result.sizeHistogram[i] += counters->sizeHistogram[i].load(std::memory_order_relaxed);
+        }
+    }
+    result.liveBytes = liveBytes_.load(std::memory_order_relaxed);
+    result.highWaterBytes = highWaterBytes_.load(std::memory_order_relaxed);
+    return result;
+}
+
+// Meant for quiescent state (e.g. between test cases), concurrent allocations may survive reset.
+inline void tracking_registry::reset()
+{
+    std::lock_guard lock { threadsMutex_ };
+    for (const auto& counters : threads_) {
+        counters->allocations = 0;
+        counters->deallocations = 0;
+        counters->allocatedBytes = 0;
+        counters->deallocatedBytes = 0;
+        counters->totalLatencyNs = 0;
+        counters->maxLatencyNs = 0;
+        for (auto& bucket : counters->sizeHistogram) {
+            bucket = 0;
+        }
+    }
+    liveBytes_ = 0;
+    highWaterBytes_ = 0;
+}
+
+inline void tracking_registry::dump_text(std::ostream& out) const
+{
+    const auto stats = snapshot();
+    out << "allocations: " << stats.allocations << '\n'
+        << "deallocations: " << stats.deallocations << '\n'
+        << "allocated bytes: " << stats.allocatedBytes << '\n'
+        << "deallocated bytes: " << stats.deallocatedBytes << '\n'
+        << "live bytes: " << stats.liveBytes << '\n'
+        << "high-water bytes: " << stats.highWaterBytes << '\n'
+        << "total latency ns: " << stats.totalLatencyNs << '\n'
+        << "max latency ns: " << stats.maxLatencyNs << '\n'
+        << "size histogram:\n";
+    for (std::size_t i = 0; i < tracking_snapshot::numOfBuckets; ++i) {
+        if (stats.sizeHistogram[i] != 0) {
+            const auto minBytes = i == 0 ? 0 : std::uint64_t { 1 } << (i - 1);
+            out << "  >= " << minBytes << " B: " << stats.sizeHistogram[i] << '\n';
+        }
+    }
+}
+
+inline void tracking_registry::dump_json(std::ostream& out) const
+{
+    const auto stats = snapshot();
+    out << "{\"allocations\":" << stats.allocations
+        << ",\"deallocations\":" << stats.deallocations
+        << ",\"allocated_bytes\":" << stats.allocatedBytes
+        << ",\"deallocated_bytes\":" << stats.deallocatedBytes
+        << ",\"live_bytes\":" << stats.liveBytes
+        << ",\"high_water_bytes\":" << stats.highWaterBytes
+        << ",\"total_latency_ns\":" << stats.totalLatencyNs
+        << ",\"max_latency_ns\":" << stats.maxLatencyNs
+        << ",\"size_histogram\":[";
+    const char* separator = "";
+    for (std::size_t i = 0; i < tracking_snapshot::numOfBuckets; ++i) {
+        if (stats.sizeHistogram[i] != 0) {
+            const auto minBytes = i == 0 ? 0 : std::uint64_t { 1 } << (i - 1);
+            out << separator << "{\"min_bytes\":" << minBytes << ",\"count\":" << stats.sizeHistogram[i] << '}';
+            separator = ",";
+        }
+    }
+    out << "]}";
+}
+
+inline tracking_registry::thread_counters& tracking_registry::getLocalCounters()
+{
+    // Counters outlive their thread, so snapshot still sees allocations made by finished threads.
+    thread_local std::shared_ptr<thread_counters> local = [this] {
+        auto counters = std::make_shared<thread_counters>();
+        std::lock_guard lock { threadsMutex_ };
+        threads_.push_back(counters);
+        return counters;
+    }();
+    return *local;
+}
+
+inline void tracking_registry::increment(std::atomic<std::uint64_t>& counter, std::uint64_t value) noexcept
+{
+    // Only owning thread writes its counters, plain load and store avoid locked instruction.
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+template <typename Inner>
+[[nodiscard]] typename tracking_allocator<Inner>::value_type* tracking_allocator<Inner>::allocate(size_type n)
+{
+    const auto start = std::chrono::steady_clock::now();
+    value_type* p = inner_.allocate(n);
+    const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    tracking_registry::instance().on_allocate(n * sizeof(value_type), static_cast<std::uint64_t>(latency.count()));
+    return p;
+}
+
+template <typename Inner>
+void tracking_allocator<Inner>::deallocate(value_type* p, size_type n)
+{
+    if (p == nullptr) {
+        return;
+    }
+    inner_.deallocate(p, n);
+    tracking_registry::instance().on_deallocate(n * sizeof(value_type));
+}
+}
@@ -1,21 +1,170 @@
 #pragma once
 
 #include <algorithm>
-#include <cmath>
+#include <array>
+#include <bit>
+#include <compare>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <iterator>
 #include <memory>
+#include <ranges>
+#include <span>
 #include <stdexcept>
+#include <tuple>
+#include <type_traits>
 #include <utility>
 
 #include "allocator.hpp"
 
 namespace my_vec {
-template <typename T, typename Allocator = my_alloc::allocator<T>>
+namespace detail {
+    struct vector_access;
+
+    /*
+    * Counterparts of std::uninitialized_* algorithms usable in constant expressions,
+    * which the standard ones are not before C++26. During constant evaluation elements
+    * are constructed one by one with std::construct_at. At runtime trivially copyable
+    * elements are copied with memcpy and filled with memset when every byte of value
+    * is the same, other types use std algorithms.
+    */
+
+    // Equality of these types is equality of their object representation, unlike floating point (-0.0 == 0.0).
+    template <typename T>
+    inline constexpr bool isBitwiseComparable = std::is_integral_v<T> || std::is_enum_v<T> || std::is_pointer_v<T>;
+
+    // These types are ordered like unsigned bytes, which is the order memcmp uses.
+    template <typename T>
+    inline constexpr bool isBytewiseOrdered = std::is_same_v<T, unsigned char> || std::is_same_v<T, char8_t> || (std::is_same_v<T, char> && std::is_unsigned_v<char>);
+
+    template <typename T>
+    inline constexpr bool isBytewiseFillable = std::is_integral_v<T> || std::is_floating_point_v<T> || std::is_enum_v<T>;
+
+    // Returns true and sets byte when object representation of value is single repeated byte.
+    template <typename T>
+    bool isRepeatedByte(const T& value, unsigned char& byte) noexcept
+    {
+        const auto bytes = std::bit_cast<std::array<unsigned char, sizeof(T)>>(value);
+        byte = bytes[0];
+        return std::all_of(bytes.begin(), bytes.end(), [&bytes](unsigned char b) { return b == bytes[0]; });
+    }
+
+    template <typename T, typename Construct>
+    constexpr void constructEach(T* first, T* last, Construct construct)
+    {
+        T* current = first;
+        try {
+            for (; current != last; ++current) {
+                construct(current);
+            }
+        } catch (...) {
+            std::destroy(first, current);
+            throw;
+        }
+    }
+
+    template <typename T>
+    constexpr void uninitializedCopy(const T* first, const T* last, T* dest)
+    {
+        if (std::is_constant_evaluated()) {
+            constructEach(dest, dest + (last - first), [&first](T* p) { std::construct_at(p, *first++); });
+        } else if constexpr (std::is_trivially_copyable_v<T>) {
+            if (first != last) {
+                std::memcpy(dest, first, static_cast<std::size_t>(last - first) * sizeof(T));
+            }
+        } else {
+            std::uninitialized_copy(first, last, dest);
+        }
+    }
+
+    template <typename T>
+    constexpr void uninitializedMove(T* first, T* last, T* dest)
+    {
+        if (std::is_constant_evaluated()) {
+            constructEach(dest, dest + (last - first), [&first](T* p) { std::construct_at(p, std::move(*first++)); });
+        } else if constexpr (std::is_trivially_copyable_v<T>) {
+            if (first != last) {
+                std::memcpy(dest, first, static_cast<std::size_t>(last - first) * sizeof(T));
+            }
+        } else {
+            std::uninitialized_move(first, last, dest);
+        }
+    }
+
+    template <typename T>
+    constexpr void uninitializedFill(T* first, T* last, const T& value)
+    {
+        if (std::is_constant_evaluated()) {
+            constructEach(first, last, [&value](T* p) { std::construct_at(p, value); });
+            return;
+        }
+        if constexpr (isBytewiseFillable<T>) {
+            unsigned char byte = 0;
+            if (isRepeatedByte(value, byte)) {
+                if (first != last) {
+                    std::memset(first, byte, static_cast<std::size_t>(last - first) * sizeof(T));
+                }
+                return;
+            }
+        }
+        std::uninitialized_fill(first, last, value);
+    }
+
+    template <typename T>
+    constexpr void uninitializedValueConstruct(T* first, T* last)
+    {
+        if (std::is_constant_evaluated()) {
+            constructEach(first, last, [](T* p) { std::construct_at(p); });
+        } else if constexpr (isBytewiseFillable<T>) {
+            // Value-initialized arithmetic values are all-zero bytes.
+            if (first != last) {
+                std::memset(first, 0, static_cast<std::size_t>(last - first) * sizeof(T));
+            }
+        } else {
+            std::uninitialized_value_construct(first, last);
+        }
+    }
+
+    // Constant evaluation cannot leave objects uninitialized, so they are value-initialized there.
+    template <typename T>
+    constexpr void uninitializedDefaultConstruct(T* first, T* last)
+    {
+        if (std::is_constant_evaluated()) {
+            constructEach(first, last, [](T* p) { std::construct_at(p); });
+        } else {
+            std::uninitialized_default_construct(first, last);
+        }
+    }
+}
+
+/*
+* Default statistics policy of vector, every hook is empty so instrumentation
+* costs nothing. See vector_stats.hpp for policy which records allocations.
+*/
+
+struct no_stats {
+    constexpr void on_allocate([[maybe_unused]] std::size_t capacityBytes) noexcept { }
+    constexpr void on_reallocate([[maybe_unused]] std::size_t bytesMoved) noexcept { }
+    constexpr void on_destroy([[maybe_unused]] std::size_t sizeBytes, [[maybe_unused]] std::size_t capacityBytes) noexcept { }
+};
+
+/*
+* Tag selecting default-initialization of new elements, elements of trivially
+* constructible types are left uninitialized so they can be overwritten without
+* paying for zeroing first.
+*/
+
+struct default_init_t {
+    explicit default_init_t() = default;
+};
+inline constexpr default_init_t default_init {};
+
+template <typename T, typename Allocator = my_alloc::allocator<T>, typename Stats = no_stats>
 class vector {
 public:
     using value_type = T;
+    using allocator_type = Allocator;
     using size_type = std::size_t;
     using reference = value_type&;
     using const_reference = const value_type&;
@@ -28,18 +177,29 @@ public:
     using difference_type = std::ptrdiff_t;
 
     constexpr vector() noexcept(noexcept(Allocator()));
+    constexpr explicit vector(const Allocator& alloc) noexcept;
     constexpr vector(size_type count, const T& value, const Allocator& alloc = Allocator());
     constexpr explicit vector(size_type count, const Allocator& alloc = Allocator());
+    constexpr vector(size_type count, default_init_t, const Allocator& alloc = Allocator());
     constexpr vector(const vector& other);
     constexpr vector& operator=(const vector& other);
     constexpr vector(vector&& other) noexcept;
     constexpr vector& operator=(vector&& other) noexcept;
     constexpr vector(std::initializer_list<T> init, const Allocator& alloc = Allocator());
     constexpr vector& operator=(std::initializer_list<T> ilist);
-    template <class InputIt>
+    template <std::input_iterator InputIt>
     constexpr vector(InputIt first, InputIt last, const Allocator& alloc = Allocator());
     constexpr ~vector() noexcept;
 
+    constexpr allocator_type get_allocator() const noexcept { return alloc_; }
+
+    constexpr void assign(size_type count, const T& value);
+    template <std::input_iterator InputIt>
+    constexpr void assign(InputIt first, InputIt last);
+    constexpr void assign(std::initializer_list<T> ilist);
+    template <std::ranges::input_range R>
+    constexpr void assign_range(R&& rg);
+
     constexpr reference at(size_type pos);
     constexpr const_reference at(size_type pos) const;
     constexpr reference operator[](size_type pos) { return elem_[pos]; }
@@ -51,15 +211,15 @@ public:
     constexpr T* data() noexcept { return elem_; }
     constexpr const T* data() const noexcept { return elem_; }
 
-    iterator begin() noexcept { return elem_; }
-    const_iterator begin() const noexcept { return elem_; }
-    iterator end() noexcept { return elem_ + size_; }
-    const_iterator end() const noexcept { return elem_ + size_; }
+    constexpr iterator begin() noexcept { return elem_; }
+    constexpr const_iterator begin() const noexcept { return elem_; }
+    constexpr iterator end() noexcept { return elem_ + size_; }
+    constexpr const_iterator end() const noexcept { return elem_ + size_; }
 
-    reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
-    const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
-    reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
-    const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
+    constexpr reverse_iterator rbegin() noexcept { return reverse_iterator(end()); }
+    constexpr const_reverse_iterator rbegin() const noexcept { return const_reverse_iterator(end()); }
+    constexpr reverse_iterator rend() noexcept { return reverse_iterator(begin()); }
+    constexpr const_reverse_iterator rend() const noexcept { return const_reverse_iterator(begin()); }
 
     [[nodiscard]] constexpr bool empty() const noexcept { return size_ == 0; }
     constexpr size_type size() const noexcept { return size_; }
@@ -69,39 +229,101 @@ public:
 
     constexpr void clear() noexcept;
     constexpr iterator insert(const_iterator pos, const T& value);
+    constexpr iterator insert(const_iterator pos, T&& value);
     constexpr iterator insert(const_iterator pos, size_type count, const T& value);
-    template <class InputIt>
+    template <std::input_iterator InputIt>
     constexpr iterator insert(const_iterator pos, InputIt first, InputIt last);
     constexpr iterator insert(const_iterator pos, std::initializer_list<T> ilist);
+    template <std::ranges::input_range R>
+    constexpr iterator insert_range(const_iterator pos, R&& rg);
+    template <std::ranges::input_range R>
+    constexpr void append_range(R&& rg);
     template <typename... Args>
     constexpr iterator emplace(const_iterator pos, Args&&... args);
     constexpr iterator erase(const_iterator pos);
+    constexpr iterator erase(const_iterator first, const_iterator last);
+    constexpr iterator unstable_erase(const_iterator pos);
     constexpr void push_back(const T& value);
     constexpr void push_back(T&& value);
     template <typename... Args>
     constexpr reference emplace_back(Args&&... args);
     constexpr void pop_back();
-    constexpr void resize(size_type count, T value = T());
+    constexpr void resize(size_type count);
+    constexpr void resize(size_type count, const T& value);
+    constexpr void resize_for_overwrite(size_type count);
+    constexpr std::span<T> append_uninitialized(size_type count);
     constexpr void swap(vector& other) noexcept;
 
+    constexpr Stats& stats() noexcept { return stats_; }
+    constexpr const Stats& stats() const noexcept { return stats_; }
+
 private:
+    friend detail::vector_access;
+
     Allocator alloc_;
     T* elem_;
     size_type size_;
     size_type space_;
+    [[no_unique_address]] Stats stats_ {};
     constexpr static size_type defaultContainerCapacity_ = 1;
+
+    constexpr size_type getGrowCapacity(size_type newSize) const noexcept;
+    template <typename Construct>
+    constexpr void reallocate(size_type new_cap, size_type newSize, Construct construct);
+    constexpr static void relocate(T* first, T* last, T* dest);
+    template <typename... Args>
+    constexpr void emplaceReallocate(size_type posDistance, Args&&... args);
+    constexpr void shiftTailRight(size_type posDistance);
 };
 
-template <typename T, typename Allocator>
-constexpr auto operator<=>(const vector<T, Allocator>& rhs, const vector<T, Allocator>& lhs)
+template <typename T, typename Allocator, typename Stats>
+constexpr auto operator<=>(const vector<T, Allocator, Stats>& rhs, const vector<T, Allocator, Stats>& lhs)
 {
+    if constexpr (detail::isBytewiseOrdered<T>) {
+        if (!std::is_constant_evaluated()) {
+            const auto commonSize = std::min(rhs.size(), lhs.size());
+            const int result = commonSize == 0 ? 0 : std::memcmp(rhs.data(), lhs.data(), commonSize);
+            return result != 0 ? result <=> 0 : rhs.size() <=> lhs.size();
+        }
+    }
     return std::lexicographical_compare_three_way(rhs.begin(), rhs.end(), lhs.begin(), lhs.end(), std::compare_three_way());
 }
 
-template <typename T, typename Allocator>
-constexpr bool operator==(const vector<T, Allocator>& lhs, const vector<T, Allocator>& rhs)
+template <typename T, typename Allocator, typename Stats>
+constexpr bool operator==(const vector<T, Allocator, Stats>& lhs, const vector<T, Allocator, Stats>& rhs)
+{
+    if (lhs.size() != rhs.size()) {
+        return false;
+    }
+    if constexpr (detail::isBitwiseComparable<T>) {
+        if (!std::is_constant_evaluated()) {
+            return lhs.size() == 0 || std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(T)) == 0;
+        }
+    }
+    return std::equal(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+}
+
+/*
+* Erase every element equal to value or satisfying pred in a single compaction
+* pass, returns number of erased elements.
+*/
+
+template <typename T, typename Allocator, typename Stats, typename U>
+constexpr typename vector<T, Allocator, Stats>::size_type erase(vector<T, Allocator, Stats>& c, const U& value)
 {
-    return lhs.size() == rhs.size() && std::equal(rhs.begin(), rhs.end(), lhs.begin(), lhs.end());
+    const auto it = std::remove(c.begin(), c.end(), value);
+    const auto numOfErased = static_cast<typename vector<T, Allocator, Stats>::size_type>(c.end() - it);
+    c.erase(it, c.end());
+    return numOfErased;
+}
+
+template <typename T, typename Allocator, typename Stats, typename Pred>
+constexpr typename vector<T, Allocator, Stats>::size_type erase_if(vector<T, Allocator, Stats>& c, Pred pred)
+{
+    const auto it = std::remove_if(c.begin(), c.end(), pred);
+    const auto numOfErased = static_cast<typename vector<T, Allocator, Stats>::size_type>(c.end() - it);
+    c.erase(it, c.end());
+    return numOfErased;
 }
 
 /*
@@ -173,7 +395,7 @@ public:
     constexpr vector& operator=(vector&& other) noexcept;
     constexpr vector(std::initializer_list<bool> init);
     constexpr vector& operator=(std::initializer_list<bool> ilist);
-    ~vector() noexcept { alloc_.deallocate(elem_, space_); }
+    constexpr ~vector() noexcept { alloc_.deallocate(elem_, getNumberOfBlocksTypeToAllocateSpace(space_)); }
 
     constexpr reference at(size_type pos);
     constexpr const_reference at(size_type pos) const;
@@ -198,7 +420,11 @@ public:
     constexpr void flip();
     constexpr static void swap(reference x, reference y);
 
+    friend constexpr bool operator==(const vector& lhs, const vector& rhs);
+
 private:
+    friend detail::vector_access;
+
     my_alloc::allocator<block_t> alloc_;
     block_t* elem_;
     size_type size_;
@@ -215,8 +441,8 @@ private:
 * Generic vector functions
 */
 
-template <typename T, typename Allocator>
-constexpr vector<T, Allocator>::vector() noexcept(noexcept(Allocator()))
+template <typename T, typename Allocator, typename Stats>
+constexpr vector<T, Allocator, Stats>::vector() noexcept(noexcept(Allocator()))
     : alloc_ { Allocator() }
     , elem_ { nullptr }
     , size_ { 0 }
@@ -224,49 +450,74 @@ constexpr vector<T, Allocator>::vector() noexcept(noexcept(Allocator()))
 {
 }
 
-template <typename T, typename Allocator>
-constexpr vector<T, Allocator>::vector(size_type count, const T& value, const Allocator& alloc)
+template <typename T, typename Allocator, typename Stats>
+constexpr vector<T, Allocator, Stats>::vector(const Allocator& alloc) noexcept
     : alloc_ { alloc }
-    , elem_ { alloc_.allocate(count) }
-    , size_ { count }
-    , space_ { count }
+    , elem_ { nullptr }
+    , size_ { 0 }
+    , space_ { 0 }
 {
-    std::uninitialized_fill_n(elem_, count, value);
 }
 
-template <typename T, typename Allocator>
-constexpr vector<T, Allocator>::vector(size_type count, const Allocator& alloc)
+template <typename T, typename Allocator, typename Stats>
+constexpr vector<T, Allocator, Stats>::vector(size_type count, const T& value, const Allocator& alloc)
+    : vector(alloc)
+{
+    reserve(count);
+    detail::uninitializedFill(elem_, elem_ + count, value);
+    size_ = count;
+}
+
+template <typename T, typename Allocator, typename Stats>
+constexpr vector<T, Allocator, Stats>::vector(size_type count, const Allocator& alloc)
     : vector(count, T(), alloc)
 {
 }
 
-template <typename T, typename Allocator>
-constexpr vector<T, Allocator>::vector(const vector<T, Allocator>& other)
-    : alloc_ { other.alloc_ }
-    , elem_ { alloc_.allocate(other.space_) }
-    , size_ { other.size_ }
-    , space_ { other.space_ }
+template <typename T, typename Allocator, typename Stats>
+constexpr vector<T, Allocator, Stats>::vector(size_type count, default_init_t, const Allocator& alloc)
+    : vector(alloc)
 {
-    std::uninitialized_copy_n(other.elem_, size_, elem_);
+    reserve(count);
+    detail::uninitializedDefaultConstruct(elem_, elem_ + count);
+    size_ = count;
 }
 
-template <typename T, typename Allocator>
-constexpr vector<T, Allocator>& vector<T, Allocator>::operator=(const vector<T, Allocator>& other)
+template <typename T, typename Allocator, typename Stats>
+constexpr vector<T, Allocator, Stats>::vector(const vector<T, Allocator, Stats>& other)
+    : vector(other.alloc_)
 {
     reserve(other.space_);
-    alloc_ = other.alloc_;
+    detail::uninitializedCopy(other.elem_, other.elem_ + other.size_, elem_);
     size_ = other.size_;
-    space_ = other.space_;
-    std::uninitialized_copy_n(other.elem_, size_, elem_);
+}
+
+template <typename T, typename Allocator, typename Stats>
+constexpr vector<T, Allocator, Stats>& vector<T, Allocator, Stats>::operator=(const vector<T, Allocator, Stats>& other)
+{
+    if (this == &other) {
+        return *this;
+    }
+    if (std::is_nothrow_copy_constructible_v<T> && other.size_ <= capacity()) {
+        clear();
+        detail::uninitializedCopy(other.elem_, other.elem_ + other.size_, elem_);
+        size_ = other.size_;
+    } else {
+        // Copy is built in fresh storage, so throwing copy constructor leaves this vector untouched.
+        reallocate(other.space_, other.size_, [&other](T* newElem) {
+            detail::uninitializedCopy(other.elem_, other.elem_ + other.size_, newElem);
+        });
+    }
     return *this;
 }
 
-template <typename T, typename Allocator>
-constexpr vector<T, Allocator>::vector(vector&& other) noexcept
+template <typename T, typename Allocator, typename Stats>
+constexpr vector<T, Allocator, Stats>::vector(vector&& other) noexcept
     : alloc_ { other.alloc_ }
     , elem_ { other.elem_ }
     , size_ { other.size_ }
     , space_ { other.space_ }
+    , stats_ { std::move(other.stats_) }
 {
     other.alloc_ = {};
     other.elem_ = nullptr;
@@ -274,13 +525,22 @@ constexpr vector<T, Allocator>::vector(vector&& other) noexcept
     other.space_ = 0;
 }
 
-template <typename T, typename Allocator>
-constexpr vector<T, Allocator>& vector<T, Allocator>::operator=(vector&& other) noexcept
+template <typename T, typename Allocator, typename Stats>
+constexpr vector<T, Allocator, Stats>& vector<T, Allocator, Stats>::operator=(vector&& other) noexcept
 {
+    if (this == &other) {
+        return *this;
+    }
+    // Storage is released like in destructor, so its statistics are reported before source's replace them.
+    stats_.on_destroy(size_ * sizeof(T), space_ * sizeof(T));
+    std::destroy(elem_, elem_ + size_);
+    alloc_.deallocate(elem_, space_);
+
     alloc_ = other.alloc_;
     elem_ = other.elem_;
     size_ = other.size_;
     space_ = other.space_;
+    stats_ = std::move(other.stats_);
     other.alloc_ = {};
     other.elem_ = nullptr;
     other.size_ = 0;
@@ -288,47 +548,88 @@ constexpr vector<T, Allocator>& vector<T, Allocator>::operator=(vector&& other)
     return *this;
 }
 
-template <typename T, typename Allocator>
-constexpr vector<T, Allocator>::vector(std::initializer_list<T> init, const Allocator& alloc)
-    : alloc_ { alloc }
-    , elem_ { alloc_.allocate(init.size()) }
-    , size_ { init.size() }
-    , space_ { init.size() }
+template <typename T, typename Allocator, typename Stats>
+constexpr vector<T, Allocator, Stats>::vector(std::initializer_list<T> init, const Allocator& alloc)
+    : vector(alloc)
 {
-    std::uninitialized_copy(init.begin(), init.end(), elem_);
+    reserve(init.size());
+    detail::uninitializedCopy(init.begin(), init.end(), elem_);
+    size_ = init.size();
 }
 
-template <typename T, typename Allocator>
-constexpr vector<T, Allocator>& vector<T, Allocator>::operator=(std::initializer_list<T> ilist)
+template <typename T, typename Allocator, typename Stats>
+constexpr vector<T, Allocator, Stats>& vector<T, Allocator, Stats>::operator=(std::initializer_list<T> ilist)
 {
-    clear();
-    reserve(ilist.size());
-    size_ = ilist.size();
-    space_ = ilist.size();
-    std::uninitialized_copy(ilist.begin(), ilist.end(), elem_);
+    assign_range(ilist);
     return *this;
 }
 
-template <typename T, typename Allocator>
-template <class InputIt>
-constexpr vector<T, Allocator>::vector(InputIt first, InputIt last, const Allocator& alloc)
-    : alloc_ { alloc }
-    , elem_ { alloc_.allocate(static_cast<size_type>(last - first)) }
-    , size_ { static_cast<size_type>(last - first) }
-    , space_ { static_cast<size_type>(last - first) }
+template <typename T, typename Allocator, typename Stats>
+template <std::input_iterator InputIt>
+constexpr vector<T, Allocator, Stats>::vector(InputIt first, InputIt last, const Allocator& alloc)
+    : vector(alloc)
 {
-    std::uninitialized_copy(first, last, elem_);
+    append_range(std::ranges::subrange(first, last));
 }
 
-template <typename T, typename Allocator>
-constexpr vector<T, Allocator>::~vector() noexcept
+template <typename T, typename Allocator, typename Stats>
+constexpr vector<T, Allocator, Stats>::~vector() noexcept
 {
+    stats_.on_destroy(size_ * sizeof(T), space_ * sizeof(T));
     std::destroy(elem_, elem_ + size_);
     alloc_.deallocate(elem_, space_);
 }
 
-template <typename T, typename Allocator>
-constexpr typename vector<T, Allocator>::reference vector<T, Allocator>::at(size_type pos)
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::assign(size_type count, const T& value)
+{
+    if (count > capacity()) {
+        // Value may refer to element of this vector, so it is copied before storage is released.
+        const T copy = value;
+        clear();
+        reserve(count);
+        detail::uninitializedFill(elem_, elem_ + count, copy);
+    } else {
+        const auto numOfAssigned = std::min(count, size_);
+        std::fill_n(elem_, numOfAssigned, value);
+        std::destroy(elem_ + numOfAssigned, elem_ + size_);
+        detail::uninitializedFill(elem_ + numOfAssigned, elem_ + count, value);
+    }
+    size_ = count;
+}
+
+template <typename T, typename Allocator, typename Stats>
+template <std::input_iterator InputIt>
+constexpr void vector<T, Allocator, Stats>::assign(InputIt first, InputIt last)
+{
+    assign_range(std::ranges::subrange(first, last));
+}
+
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::assign(std::initializer_list<T> ilist)
+{
+    assign_range(ilist);
+}
+
+template <typename T, typename Allocator, typename Stats>
+template <std::ranges::input_range R>
+constexpr void vector<T, Allocator, Stats>::assign_range(R&& rg)
+{
+    clear();
+    if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+        // Old elements are already destroyed, so whole range is stored in single allocation of exact size.
+        reserve(static_cast<size_type>(std::ranges::distance(rg)));
+        for (auto&& element : rg) {
+            std::construct_at(elem_ + size_, std::forward<decltype(element)>(element));
+            ++size_;
+        }
+    } else {
+        append_range(std::forward<R>(rg));
+    }
+}
+
+template <typename T, typename Allocator, typename Stats>
+constexpr typename vector<T, Allocator, Stats>::reference vector<T, Allocator, Stats>::at(size_type pos)
 {
     if (pos >= size()) {
         throw std::out_of_range { "Position not within range of vector" };
@@ -336,8 +637,8 @@ constexpr typename vector<T, Allocator>::reference vector<T, Allocator>::at(size
     return elem_[pos];
 }
 
-template <typename T, typename Allocator>
-constexpr typename vector<T, Allocator>::const_reference vector<T, Allocator>::at(size_type pos) const
+template <typename T, typename Allocator, typename Stats>
+constexpr typename vector<T, Allocator, Stats>::const_reference vector<T, Allocator, Stats>::at(size_type pos) const
 {
     if (pos >= size()) {
         throw std::out_of_range { "Position not within range of vector" };
@@ -345,189 +646,266 @@ constexpr typename vector<T, Allocator>::const_reference vector<T, Allocator>::a
     return elem_[pos];
 }
 
-template <typename T, typename Allocator>
-constexpr void vector<T, Allocator>::reserve(size_type new_cap)
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::reserve(size_type new_cap)
 {
     if (new_cap > capacity()) {
-        T* tmp = alloc_.allocate(new_cap);
-        std::uninitialized_copy_n(elem_, size_, tmp);
-
-        std::destroy_n(elem_, size_);
-        alloc_.deallocate(elem_, space_);
-
-        elem_ = tmp;
-        space_ = new_cap;
+        reallocate(new_cap, size_, [this](T* newElem) { relocate(elem_, elem_ + size_, newElem); });
     }
 }
 
-template <typename T, typename Allocator>
-constexpr void vector<T, Allocator>::shrink_to_fit()
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::shrink_to_fit()
 {
-    reserve(size_);
-    space_ = size_;
+    if (size_ == 0) {
+        alloc_.deallocate(elem_, space_);
+        elem_ = nullptr;
+        space_ = 0;
+    } else if (size_ < space_) {
+        reallocate(size_, size_, [this](T* newElem) { relocate(elem_, elem_ + size_, newElem); });
+    }
 }
 
-template <typename T, typename Allocator>
-constexpr void vector<T, Allocator>::clear() noexcept
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::clear() noexcept
 {
     std::destroy(elem_, elem_ + size_);
     size_ = 0;
 }
 
-template <typename T, typename Allocator>
-constexpr typename vector<T, Allocator>::iterator vector<T, Allocator>::insert(const_iterator pos, const T& value)
+template <typename T, typename Allocator, typename Stats>
+constexpr typename vector<T, Allocator, Stats>::iterator vector<T, Allocator, Stats>::insert(const_iterator pos, const T& value)
 {
-    const auto posDistance = static_cast<size_type>(pos - elem_);
-    if (size() == capacity()) {
-        reserve(capacity() == 0 ? defaultContainerCapacity_ : 2 * capacity());
-        pos = elem_ + posDistance;
-    }
-
-    std::uninitialized_copy(elem_ + posDistance, elem_ + size_, elem_ + posDistance + 1);
-    size_++;
+    return emplace(pos, value);
+}
 
-    elem_[posDistance] = value;
-    return elem_ + posDistance;
+template <typename T, typename Allocator, typename Stats>
+constexpr typename vector<T, Allocator, Stats>::iterator vector<T, Allocator, Stats>::insert(const_iterator pos, T&& value)
+{
+    return emplace(pos, std::move(value));
 }
 
-template <typename T, typename Allocator>
-constexpr typename vector<T, Allocator>::iterator vector<T, Allocator>::insert(const_iterator pos, size_type count, const T& value)
+template <typename T, typename Allocator, typename Stats>
+constexpr typename vector<T, Allocator, Stats>::iterator vector<T, Allocator, Stats>::insert(const_iterator pos, size_type count, const T& value)
 {
     const auto posDistance = static_cast<size_type>(pos - elem_);
-    if (capacity() == 0) {
-        reserve(count);
-        pos = elem_ + posDistance;
-    } else if (size_ + count >= capacity()) {
-        reserve(size() + count);
-        pos = elem_ + posDistance;
+    const auto oldSize = size_;
+    if (size_ + count > capacity()) {
+        // Value may refer to element of this vector, so it is copied before storage is released.
+        const T copy = value;
+        reserve(getGrowCapacity(size_ + count));
+        detail::uninitializedFill(elem_ + size_, elem_ + size_ + count, copy);
+    } else {
+        detail::uninitializedFill(elem_ + size_, elem_ + size_ + count, value);
     }
-
-    std::uninitialized_copy(elem_ + posDistance, elem_ + size_, elem_ + posDistance + count);
-    std::uninitialized_fill(elem_ + posDistance, elem_ + posDistance + count, value);
-
     size_ += count;
+
+    std::rotate(elem_ + posDistance, elem_ + oldSize, elem_ + size_);
     return elem_ + posDistance;
 }
 
-template <typename T, typename Allocator>
-template <class InputIt>
-constexpr typename vector<T, Allocator>::iterator vector<T, Allocator>::insert(const_iterator pos, InputIt first, InputIt last)
+template <typename T, typename Allocator, typename Stats>
+template <std::input_iterator InputIt>
+constexpr typename vector<T, Allocator, Stats>::iterator vector<T, Allocator, Stats>::insert(const_iterator pos, InputIt first, InputIt last)
 {
-    const auto posDistance = static_cast<size_type>(pos - elem_);
-    const auto count = static_cast<size_type>(last - first);
+    return insert_range(pos, std::ranges::subrange(first, last));
+}
 
-    if (capacity() == 0) {
-        reserve(count);
-        pos = elem_ + posDistance;
-    } else if (size_ + count >= capacity()) {
-        reserve(size() + count);
-        pos = elem_ + posDistance;
-    }
+template <typename T, typename Allocator, typename Stats>
+constexpr typename vector<T, Allocator, Stats>::iterator vector<T, Allocator, Stats>::insert(const_iterator pos, std::initializer_list<T> ilist)
+{
+    return insert_range(pos, ilist);
+}
 
-    std::uninitialized_copy(elem_ + posDistance, elem_ + size_, elem_ + posDistance + count);
-    std::uninitialized_copy(first, last, elem_ + posDistance);
+template <typename T, typename Allocator, typename Stats>
+template <std::ranges::input_range R>
+constexpr typename vector<T, Allocator, Stats>::iterator vector<T, Allocator, Stats>::insert_range(const_iterator pos, R&& rg)
+{
+    // New elements are appended in one pass and rotated into place, which also serves input-only ranges of unknown length.
+    const auto posDistance = static_cast<size_type>(pos - elem_);
+    const auto oldSize = size_;
+    append_range(std::forward<R>(rg));
 
-    size_ += count;
+    std::rotate(elem_ + posDistance, elem_ + oldSize, elem_ + size_);
     return elem_ + posDistance;
 }
 
-template <typename T, typename Allocator>
-constexpr typename vector<T, Allocator>::iterator vector<T, Allocator>::insert(const_iterator pos, std::initializer_list<T> ilist)
+template <typename T, typename Allocator, typename Stats>
+template <std::ranges::input_range R>
+constexpr void vector<T, Allocator, Stats>::append_range(R&& rg)
 {
-    const auto posDistance = static_cast<size_type>(pos - elem_);
-
-    if (capacity() == 0) {
-        reserve(ilist.size());
-        pos = elem_ + posDistance;
-    } else if (size_ + ilist.size() >= capacity()) {
-        reserve(size() + ilist.size());
-        pos = elem_ + posDistance;
+    if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+        const auto count = static_cast<size_type>(std::ranges::distance(rg));
+        if (size_ + count > capacity()) {
+            reserve(getGrowCapacity(size_ + count));
+        }
     }
 
-    std::uninitialized_copy(elem_ + posDistance, elem_ + size_, elem_ + posDistance + ilist.size());
-    std::uninitialized_copy(ilist.begin(), ilist.end(), elem_ + posDistance);
-
-    size_ += ilist.size();
-    return elem_ + posDistance;
+    const auto oldSize = size_;
+    try {
+        if constexpr (std::ranges::forward_range<R> || std::ranges::sized_range<R>) {
+            for (auto&& element : rg) {
+                std::construct_at(elem_ + size_, std::forward<decltype(element)>(element));
+                ++size_;
+            }
+        } else {
+            for (auto&& element : rg) {
+                emplace_back(std::forward<decltype(element)>(element));
+            }
+        }
+    } catch (...) {
+        std::destroy(elem_ + oldSize, elem_ + size_);
+        size_ = oldSize;
+        throw;
+    }
 }
 
-template <typename T, typename Allocator>
+template <typename T, typename Allocator, typename Stats>
 template <typename... Args>
-constexpr typename vector<T, Allocator>::iterator vector<T, Allocator>::emplace(const_iterator pos, Args&&... args)
+constexpr typename vector<T, Allocator, Stats>::iterator vector<T, Allocator, Stats>::emplace(const_iterator pos, Args&&... args)
 {
     const auto posDistance = static_cast<size_type>(pos - elem_);
-    if (size() == capacity()) {
-        reserve(capacity() == 0 ? defaultContainerCapacity_ : 2 * capacity());
-        pos = elem_ + posDistance;
+    if (posDistance == size_) {
+        emplace_back(std::forward<Args>(args)...);
+    } else if (size_ == capacity()) {
+        emplaceReallocate(posDistance, std::forward<Args>(args)...);
+    } else if constexpr (sizeof...(Args) == 1 && (std::is_same_v<Args, T> && ...)) {
+        // Rvalue of T is moved straight into the gap, standard allows assuming it is not an element of this vector.
+        shiftTailRight(posDistance);
+        elem_[posDistance] = (std::move(args), ...);
+    } else {
+        // Arguments may refer to elements which are about to be shifted, so new value is built first.
+        T value(std::forward<Args>(args)...);
+        shiftTailRight(posDistance);
+        elem_[posDistance] = std::move(value);
     }
-    std::uninitialized_copy(elem_ + posDistance, elem_ + size_, elem_ + posDistance + 1);
-    size_++;
-
-    std::construct_at(&elem_[posDistance], std::forward<Args>(args)...);
     return elem_ + posDistance;
 }
 
-template <typename T, typename Allocator>
-constexpr typename vector<T, Allocator>::iterator vector<T, Allocator>::erase(const_iterator pos)
+template <typename T, typename Allocator, typename Stats>
+constexpr typename vector<T, Allocator, Stats>::iterator vector<T, Allocator, Stats>::erase(const_iterator pos)
 {
-    (*pos).~T();
-    size_--;
-    const auto posDistance = static_cast<size_type>(pos - elem_);
-    for (auto itCurrent = elem_ + posDistance, itNext = itCurrent + 1; itCurrent != elem_ + size_; ++itCurrent, ++itNext) {
-        *itCurrent = *itNext;
+    return erase(pos, pos + 1);
+}
+
+template <typename T, typename Allocator, typename Stats>
+constexpr typename vector<T, Allocator, Stats>::iterator vector<T, Allocator, Stats>::erase(const_iterator first, const_iterator last)
+{
+    const auto firstDistance = static_cast<size_type>(first - elem_);
+    if (first != last) {
+        // Tail is shifted once over whole erased range, leftover moved-from elements are destroyed.
+        auto newEnd = std::move(elem_ + (last - elem_), elem_ + size_, elem_ + firstDistance);
+        std::destroy(newEnd, elem_ + size_);
+        size_ = static_cast<size_type>(newEnd - elem_);
     }
+    return elem_ + firstDistance;
+}
 
+template <typename T, typename Allocator, typename Stats>
+constexpr typename vector<T, Allocator, Stats>::iterator vector<T, Allocator, Stats>::unstable_erase(const_iterator pos)
+{
+    const auto posDistance = static_cast<size_type>(pos - elem_);
+    if (posDistance != size_ - 1) {
+        elem_[posDistance] = std::move(elem_[size_ - 1]);
+    }
+    pop_back();
     return elem_ + posDistance;
 }
 
-template <typename T, typename Allocator>
-constexpr void vector<T, Allocator>::push_back(const T& value)
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::push_back(const T& value)
 {
-    if (capacity() == 0) {
-        reserve(defaultContainerCapacity_);
-    } else if (size() >= capacity()) {
-        reserve(2 * capacity());
-    }
-    elem_[size_++] = value;
+    emplace_back(value);
 }
 
-template <typename T, typename Allocator>
-constexpr void vector<T, Allocator>::push_back(T&& value)
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::push_back(T&& value)
 {
     emplace_back(std::move(value));
 }
 
-template <typename T, typename Allocator>
+template <typename T, typename Allocator, typename Stats>
 template <typename... Args>
-constexpr typename vector<T, Allocator>::reference vector<T, Allocator>::emplace_back(Args&&... args)
+constexpr typename vector<T, Allocator, Stats>::reference vector<T, Allocator, Stats>::emplace_back(Args&&... args)
 {
-    if (capacity() == 0) {
-        reserve(defaultContainerCapacity_);
-    } else if (size() >= capacity()) {
-        reserve(2 * capacity());
+    if (size_ < capacity()) {
+        std::construct_at(elem_ + size_, std::forward<Args>(args)...);
+        ++size_;
+    } else {
+        // New element is constructed before old ones are relocated, arguments may refer to them.
+        reallocate(getGrowCapacity(size_ + 1), size_ + 1, [&](T* newElem) {
+            std::construct_at(newElem + size_, std::forward<Args>(args)...);
+            try {
+                relocate(elem_, elem_ + size_, newElem);
+            } catch (...) {
+                std::destroy_at(newElem + size_);
+                throw;
+            }
+        });
     }
-    std::construct_at(&elem_[size_], std::forward<Args>(args)...);
-    return elem_[size_++];
+    return elem_[size_ - 1];
 }
 
-template <typename T, typename Allocator>
-constexpr void vector<T, Allocator>::pop_back()
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::pop_back()
 {
-    elem_[--size_].~T();
+    std::destroy_at(elem_ + --size_);
 }
 
-template <typename T, typename Allocator>
-constexpr void vector<T, Allocator>::resize(size_type count, T value)
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::resize(size_type count)
 {
-    reserve(count);
-    if (count > size()) {
-        std::uninitialized_fill(elem_ + size_, elem_ + count, value);
+    if (count <= size()) {
+        std::destroy(elem_ + count, elem_ + size_);
+    } else {
+        reserve(count);
+        detail::uninitializedValueConstruct(elem_ + size_, elem_ + count);
+    }
+    size_ = count;
+}
+
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::resize(size_type count, const T& value)
+{
+    if (count <= size()) {
+        std::destroy(elem_ + count, elem_ + size_);
+    } else if (count > capacity()) {
+        // Value may refer to element of this vector, so it is copied before storage is released.
+        const T copy = value;
+        reserve(count);
+        detail::uninitializedFill(elem_ + size_, elem_ + count, copy);
+    } else {
+        detail::uninitializedFill(elem_ + size_, elem_ + count, value);
+    }
+    size_ = count;
+}
+
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::resize_for_overwrite(size_type count)
+{
+    if (count <= size()) {
+        std::destroy(elem_ + count, elem_ + size_);
+    } else {
+        reserve(count);
+        detail::uninitializedDefaultConstruct(elem_ + size_, elem_ + count);
     }
     size_ = count;
 }
 
-template <typename T, typename Allocator>
-constexpr void vector<T, Allocator>::swap(vector& other) noexcept
+template <typename T, typename Allocator, typename Stats>
+constexpr std::span<T> vector<T, Allocator, Stats>::append_uninitialized(size_type count)
+{
+    const auto oldSize = size_;
+    if (size_ + count > capacity()) {
+        reserve(std::max(size_ + count, 2 * capacity()));
+    }
+    detail::uninitializedDefaultConstruct(elem_ + size_, elem_ + size_ + count);
+    size_ += count;
+    return std::span<T>(elem_ + oldSize, count);
+}
+
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::swap(vector& other) noexcept
 {
     T* tmpElem = other.elem_;
     size_type tmpSize = other.size_;
@@ -540,6 +918,87 @@ constexpr void vector<T, Allocator>::swap(vector& other) noexcept
     elem_ = tmpElem;
     size_ = tmpSize;
     space_ = tmpSpace;
+
+    using std::swap;
+    swap(stats_, other.stats_);
+}
+
+template <typename T, typename Allocator, typename Stats>
+constexpr typename vector<T, Allocator, Stats>::size_type vector<T, Allocator, Stats>::getGrowCapacity(size_type newSize) const noexcept
+{
+    // Growing at least geometrically keeps repeated appends amortized linear.
+    return std::max(newSize, capacity() == 0 ? defaultContainerCapacity_ : 2 * capacity());
+}
+
+template <typename T, typename Allocator, typename Stats>
+template <typename Construct>
+constexpr void vector<T, Allocator, Stats>::reallocate(size_type new_cap, size_type newSize, Construct construct)
+{
+    // Old storage is released only after construct filled new one, so exception leaves vector untouched.
+    T* tmp = alloc_.allocate(new_cap);
+    try {
+        construct(tmp);
+    } catch (...) {
+        alloc_.deallocate(tmp, new_cap);
+        throw;
+    }
+    stats_.on_allocate(new_cap * sizeof(T));
+    if (elem_ != nullptr) {
+        stats_.on_reallocate(size_ * sizeof(T));
+    }
+
+    std::destroy(elem_, elem_ + size_);
+    alloc_.deallocate(elem_, space_);
+
+    elem_ = tmp;
+    size_ = newSize;
+    space_ = new_cap;
+}
+
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::relocate(T* first, T* last, T* dest)
+{
+    // Elements are moved only when it cannot throw, otherwise they are copied so source stays intact on failure.
+    if constexpr (std::is_nothrow_move_constructible_v<T> || !std::is_copy_constructible_v<T>) {
+        detail::uninitializedMove(first, last, dest);
+    } else {
+        detail::uninitializedCopy(first, last, dest);
+    }
+}
+
+template <typename T, typename Allocator, typename Stats>
+template <typename... Args>
+constexpr void vector<T, Allocator, Stats>::emplaceReallocate(size_type posDistance, Args&&... args)
+{
+    // New buffer is built in single pass: new element first, as arguments may refer to old elements,
+    // then prefix and suffix are relocated around it, so every old element moves exactly once.
+    reallocate(getGrowCapacity(size_ + 1), size_ + 1, [&](T* newElem) {
+        std::construct_at(newElem + posDistance, std::forward<Args>(args)...);
+        try {
+            relocate(elem_, elem_ + posDistance, newElem);
+        } catch (...) {
+            std::destroy_at(newElem + posDistance);
+            throw;
+        }
+        try {
+            relocate(elem_ + posDistance, elem_ + size_, newElem + posDistance + 1);
+        } catch (...) {
+            std::destroy(newElem, newElem + posDistance + 1);
+            throw;
+        }
+    });
+}
+
+template <typename T, typename Allocator, typename Stats>
+constexpr void vector<T, Allocator, Stats>::shiftTailRight(size_type posDistance)
+{
+    // Last element is moved into raw slot past the end, remaining ones are moved over live objects.
+    const auto oldSize = size_;
+    std::construct_at(elem_ + oldSize, std::move(elem_[oldSize - 1]));
+    ++size_;
+    for (auto i = oldSize - 1; i > posDistance; --i) {
+        elem_[i] = std::move(elem_[i - 1]);
+    }
 }
 
 /*
@@ -558,7 +1017,7 @@ constexpr vector<bool>::vector(size_type count, bool value)
     , size_ { count }
     , space_ { getCapacityValueForAllocatedSpace(count) }
 {
-    std::uninitialized_fill_n(elem_, getNumberOfBlocksTypeToAllocateSpace(count), block_t {});
+    std::fill_n(elem_, getNumberOfBlocksTypeToAllocateSpace(count), block_t {});
     for (size_type i = 0; i < count; ++i) {
         setValueAtPosition(i, value);
     }
@@ -569,7 +1028,7 @@ constexpr vector<bool>::vector(const vector& other)
     , size_ { other.size_ }
     , space_ { other.space_ }
 {
-    std::uninitialized_fill_n(elem_, getNumberOfBlocksTypeToAllocateSpace(space_), block_t {});
+    std::fill_n(elem_, getNumberOfBlocksTypeToAllocateSpace(space_), block_t {});
     for (size_type i = 0; i < size(); ++i) {
         const auto [blockWithBit, mask] = getBlockWithBitAndMask(i);
         const auto value = !!(other.elem_[blockWithBit] & mask);
@@ -602,6 +1061,11 @@ constexpr vector<bool>::vector(vector&& other) noexcept
 
 constexpr vector<bool>& vector<bool>::operator=(vector&& other) noexcept
 {
+    if (this == &other) {
+        return *this;
+    }
+    alloc_.deallocate(elem_, getNumberOfBlocksTypeToAllocateSpace(space_));
+
     elem_ = other.elem_;
     size_ = other.size_;
     space_ = other.space_;
@@ -616,7 +1080,7 @@ constexpr vector<bool>::vector(std::initializer_list<bool> init)
     , size_ { init.size() }
     , space_ { getCapacityValueForAllocatedSpace(init.size()) }
 {
-    std::uninitialized_fill_n(elem_, getNumberOfBlocksTypeToAllocateSpace(space_), block_t {});
+    std::fill_n(elem_, getNumberOfBlocksTypeToAllocateSpace(space_), block_t {});
     size_type arrIndex = 0;
     for (const auto& el : init) {
         const auto [blockWithBit, mask] = getBlockWithBitAndMask(arrIndex++);
@@ -628,7 +1092,6 @@ constexpr vector<bool>& vector<bool>::operator=(std::initializer_list<bool> ilis
 {
     reserve(ilist.size());
     size_ = ilist.size();
-    space_ = getCapacityValueForAllocatedSpace(ilist.size());
 
     size_type arrIndex = 0;
     for (const auto& el : ilist) {
@@ -696,14 +1159,14 @@ constexpr void vector<bool>::reserve(size_type new_cap)
 {
     if (new_cap > capacity()) {
         block_t* tmp = alloc_.allocate(getNumberOfBlocksTypeToAllocateSpace(new_cap));
-        std::uninitialized_fill_n(tmp, getNumberOfBlocksTypeToAllocateSpace(new_cap), block_t {});
+        std::fill_n(tmp, getNumberOfBlocksTypeToAllocateSpace(new_cap), block_t {});
         for (size_type i = 0; i < size(); ++i) {
             const auto [blockWithBit, mask] = getBlockWithBitAndMask(i);
             const auto value = !!(elem_[blockWithBit] & mask);
             tmp[blockWithBit] ^= (-value ^ tmp[blockWithBit]) & mask;
         }
 
-        alloc_.deallocate(elem_, space_);
+        alloc_.deallocate(elem_, getNumberOfBlocksTypeToAllocateSpace(space_));
         elem_ = tmp;
         space_ = getCapacityValueForAllocatedSpace(new_cap);
     }
@@ -738,7 +1201,7 @@ constexpr void vector<bool>::push_back(const value_type& value)
 
 constexpr void vector<bool>::pop_back()
 {
-    setValueAtPosition(size_--, false);
+    setValueAtPosition(--size_, false);
 }
 
 constexpr void vector<bool>::swap(vector& other) noexcept
@@ -773,7 +1236,7 @@ constexpr void vector<bool>::swap(reference x, reference y)
 
 constexpr inline vector<bool>::size_type vector<bool>::getNumberOfBlocksTypeToAllocateSpace(size_type count) const
 {
-    return static_cast<size_type>(std::ceil(static_cast<double>(count) / static_cast<double>(getBlockCapacity())));
+    return (count + getBlockCapacity() - 1) / getBlockCapacity();
 }
 
 constexpr inline vector<bool>::size_type vector<bool>::getCapacityValueForAllocatedSpace(size_type count) const
@@ -794,4 +1257,45 @@ constexpr void vector<bool>::setValueAtPosition(size_type position, bool value)
     const auto [blockWithBit, mask] = getBlockWithBitAndMask(position);
     elem_[blockWithBit] ^= (-value ^ elem_[blockWithBit]) & mask;
 }
+
+constexpr bool operator==(const vector<bool>& lhs, const vector<bool>& rhs)
+{
+    if (lhs.size_ != rhs.size_) {
+        return false;
+    }
+    // Bits past size() in last block are leftovers of earlier values, so they are masked out.
+    const auto numOfFullBlocks = lhs.size_ / lhs.getBlockCapacity();
+    if (!std::equal(lhs.elem_, lhs.elem_ + numOfFullBlocks, rhs.elem_)) {
+        return false;
+    }
+    const auto usedBits = lhs.size_ % lhs.getBlockCapacity();
+    if (usedBits == 0) {
+        return true;
+    }
+    const auto mask = (1ULL << usedBits) - 1;
+    return ((lhs.elem_[numOfFullBlocks] ^ rhs.elem_[numOfFullBlocks]) & mask) == 0;
+}
+
+/*
+* Access to vector internals for library extensions (parallel algorithms,
+* serialization) which fill or read storage behind the vector's back.
+*/
+
+namespace detail {
+    struct vector_access {
+        template <typename T, typename Allocator, typename Stats>
+        constexpr static void setSize(vector<T, Allocator, Stats>& vec, typename vector<T, Allocator, Stats>::size_type size) noexcept
+        {
+            vec.size_ = size;
+        }
+
+        constexpr static std::uint64_t* getBlocks(vector<bool>& vec) noexcept { return vec.elem_; }
+        constexpr static const std::uint64_t* getBlocks(const vector<bool>& vec) noexcept { return vec.elem_; }
+        constexpr static std::size_t getNumberOfBlocks(const vector<bool>& vec) noexcept
+        {
+            return vec.getNumberOfBlocksTypeToAllocateSpace(vec.size_);
+        }
+        constexpr static void setSize(vector<bool>& vec, std::size_t size) noexcept { vec.size_ = size; }
+    };
+}
 }
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+
+#include "vector.hpp"
+
+namespace my_vec {
+/*
+* std::hash support for vector and vector<bool>.
+* Vectors of elements whose equality is equality of bytes (integral, enum, pointer)
+* are hashed in one pass over data() with wyhash-style kernel, which consumes
+* 48 bytes per iteration in three independent lanes. vector<bool> hashes its
+* blocks the same way with bits past size() masked out. Other element types
+* fall back to combining std::hash of every element.
+*/
+
+namespace detail {
+    constexpr std::uint64_t hashSecret0 = 0xa0761d6478bd642full;
+    constexpr std::uint64_t hashSecret1 = 0xe7037ed1a0b428dbull;
+    constexpr std::uint64_t hashSecret2 = 0x8ebc6af09c88c6e3ull;
+    constexpr std::uint64_t hashSecret3 = 0x589965cc75374cc3ull;
+
+    // Multiplies a and b into 128 bits and folds it with xor.
+    inline std::uint64_t hashMix(std::uint64_t a, std::uint64_t b) noexcept
+    {
+#if defined(__SIZEOF_INT128__)
+        __extension__ using uint128_t = unsigned __int128;
+        const auto product = static_cast<uint128_t>(a) * b;
+        return static_cast<std::uint64_t>(product) ^ static_cast<std::uint64_t>(product >> 64);
+#else
+        const std::uint64_t aHigh = a >> 32, aLow = static_cast<std::uint32_t>(a);
+        const std::uint64_t bHigh = b >> 32, bLow = static_cast<std::uint32_t>(b);
+        const std::uint64_t lowLow = aLow * bLow, lowHigh = aLow * bHigh, highLow = aHigh * bLow, highHigh = aHigh * bHigh;
+        const std::uint64_t middle = (lowLow >> 32) + static_cast<std::uint32_t>(lowHigh) + static_cast<std::uint32_t>(highLow);
+        const std::uint64_t low = (middle << 32) | static_cast<std::uint32_t>(lowLow);
+        const std::uint64_t high = highHigh + (lowHigh >> 32) + (highLow >> 32) + (middle >> 32);
+        return low ^ high;
+#endif
+    }
+
+    inline std::uint64_t hashRead8(const unsigned char* p) noexcept
+    {
+        std::uint64_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline std::uint64_t hashRead4(const unsigned char* p) noexcept
+    {
+        std::uint32_t value;
+        std::memcpy(&value, p, sizeof(value));
+        return value;
+    }
+
+    inline std::uint64_t hashBytes(const void* data, std::size_t length, std::uint64_t seed) noexcept
+    {
+        const auto* p = static_cast<const unsigned char*>(data);
+        seed ^= hashMix(seed ^ hashSecret0, hashSecret1);
+
+        std::uint64_t a = 0;
+        std::uint64_t b = 0;
+        if (length <= 16) {
+            if (length >= 4) {
+                // Two possibly overlapping 4-byte reads from each end cover any length in [4, 16].
+                const auto offset = (length >> 3) << 2;
+                a = (hashRead4(p) << 32) | hashRead4(p + offset);
+                b = (hashRead4(p + length - 4) << 32) | hashRead4(p + length - 4 - offset);
+            } else if (length > 0) {
+                a = (std::uint64_t { p[0] } << 16) | (std::uint64_t { p[length >> 1] } << 8) | p[length - 1];
+            }
+        } else {
+            auto remaining = length;
+            if (remaining > 48) {
+                auto seed1 = seed;
+                auto seed2 = seed;
+                do {
+                    seed = hashMix(hashRead8(p) ^ hashSecret1, hashRead8(p + 8) ^ seed);
+                    seed1 = hashMix(hashRead8(p + 16) ^ hashSecret2, hashRead8(p + 24) ^ seed1);
+                    seed2 = hashMix(hashRead8(p + 32) ^ hashSecret3, hashRead8(p + 40) ^ seed2);
+                    p += 48;
+                    remaining -= 48;
+                } while (remaining > 48);
+                seed ^= seed1 ^ seed2;
+            }
+            while (remaining > 16) {
+                seed = hashMix(hashRead8(p) ^ hashSecret1, hashRead8(p + 8) ^ seed);
+                p += 16;
+                remaining -= 16;
+            }
+            a = hashRead8(p + remaining - 16);
+            b = hashRead8(p + remaining - 8);
+        }
+        return hashMix(hashMix(a ^ hashSecret1, b ^ seed) ^ hashSecret0 ^ length, hashSecret1);
+    }
+
+    inline std::uint64_t hashCombine(std::uint64_t seed, std::uint64_t value) noexcept
+    {
+        return hashMix(seed ^ value, hashSecret1 ^ hashSecret2);
+    }
+}
+}
+
+template <typename T, typename Allocator, typename Stats>
+struct std::hash<my_vec::vector<T, Allocator, Stats>> {
+    std::size_t operator()(const my_vec::vector<T, Allocator, Stats>& vec) const
+    {
+        if constexpr (my_vec::detail::isBitwiseComparable<T>) {
+            return static_cast<std::size_t>(my_vec::detail::hashBytes(vec.data(), vec.size() * sizeof(T), 0));
+        } else {
+            std::uint64_t seed = my_vec::detail::hashCombine(my_vec::detail::hashSecret0, vec.size());
+            for (const auto& element : vec) {
+                seed = my_vec::detail::hashCombine(seed, static_cast<std::uint64_t>(std::hash<T> {}(element)));
+            }
+            return static_cast<std::size_t>(seed);
+        }
+    }
+};
+
+template <>
+struct std::hash<my_vec::vector<bool>> {
+    std::size_t operator()(const my_vec::vector<bool>& vec) const noexcept
+    {
+        using block_t = std::uint64_t;
+        constexpr std::size_t bitsInBlock = 8 * sizeof(block_t);
+        const auto* blocks = my_vec::detail::vector_access::getBlocks(vec);
+        const auto numOfBlocks = my_vec::detail::vector_access::getNumberOfBlocks(vec);
+        const auto usedBits = vec.size() % bitsInBlock;
+
+        // Bits past size() may keep values of erased elements, so last block is hashed separately with them cleared.
+        const auto numOfFullBlocks = usedBits == 0 ? numOfBlocks : numOfBlocks - 1;
+        auto seed = my_vec::detail::hashBytes(blocks, numOfFullBlocks * sizeof(block_t), vec.size());
+        if (usedBits != 0) {
+            const block_t lastBlock = blocks[numOfBlocks - 1] & ((block_t { 1 } << usedBits) - 1);
+            seed = my_vec::detail::hashCombine(seed, lastBlock);
+        }
+        return static_cast<std::size_t>(seed);
+    }
+};
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <utility>
+
+#include "vector.hpp"
+
+namespace my_vec {
+/*
+* Statistics policy for vector which records allocation behaviour of single
+* instance and, on destruction, adds it to process-wide stats_registry under
+* call site given by tag(). Only tagged instances which allocated are recorded,
+* statistics travel with storage when vector is moved or swapped. Usage:
+*   my_vec::vector<int, my_alloc::allocator<int>, my_vec::vector_stats> vec;
+*   vec.stats().tag();
+*/
+
+struct allocation_counters {
+    std::size_t instances = 0;
+    std::size_t allocations = 0;
+    std::size_t reallocations = 0;
+    std::size_t bytesMoved = 0;
+    std::size_t peakCapacityBytes = 0;
+    std::size_t wastedBytesAtDestruction = 0;
+};
+
+class stats_registry {
+public:
+    static stats_registry& instance();
+
+    void record(const std::string& site, const allocation_counters& counters);
+    std::map<std::string, allocation_counters> snapshot() const;
+    void reset();
+    void dump(std::ostream& out) const;
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, allocation_counters> sites_;
+};
+
+class vector_stats {
+public:
+    constexpr static const char* untaggedSite = "<untagged>";
+
+    vector_stats() = default;
+    vector_stats(const vector_stats&) = delete;
+    vector_stats& operator=(const vector_stats&) = delete;
+    vector_stats(vector_stats&& other) noexcept;
+    vector_stats& operator=(vector_stats&& other) noexcept;
+    ~vector_stats() = default;
+
+    void tag(std::string site) { site_ = std::move(site); }
+    void tag(const std::source_location location = std::source_location::current());
+    const std::string& site() const noexcept { return site_; }
+    const allocation_counters& counters() const noexcept { return counters_; }
+
+    void on_allocate(std::size_t capacityBytes) noexcept;
+    void on_reallocate(std::size_t bytesMoved) noexcept;
+    void on_destroy(std::size_t sizeBytes, std::size_t capacityBytes) noexcept;
+
+private:
+    std::string site_ { untaggedSite };
+    allocation_counters counters_ {};
+};
+
+inline stats_registry& stats_registry::instance()
+{
+    static stats_registry registry;
+    return registry;
+}
+
+inline void stats_registry::record(const std::string& site, const allocation_counters& counters)
+{
+    std::lock_guard lock { mutex_ };
+    auto& total = sites_[site];
+    total.instances += counters.instances;
+    total.allocations += counters.allocations;
+    total.reallocations += counters.reallocations;
+    total.bytesMoved += counters.bytesMoved;
+    total.peakCapacityBytes = std::max(total.peakCapacityBytes, counters.peakCapacityBytes);
+    total.wastedBytesAtDestruction += counters.wastedBytesAtDestruction;
+}
+
+inline std::map<std::string, allocation_counters> stats_registry::snapshot() const
+{
+    std::lock_guard lock { mutex_ };
+    return sites_;
+}
+
+inline void stats_registry::reset()
+{
+    std::lock_guard lock { mutex_ };
+    sites_.clear();
+}
+
+inline void stats_registry::dump(std::ostream& out) const
+{
+    for (const auto& [site, counters] : snapshot()) {
+        out << site << ": instances=" << counters.instances
+            << " allocations=" << counters.allocations
+            << " reallocations=" << counters.reallocations
+            << " bytes_moved=" << counters.bytesMoved
+            << " peak_capacity_bytes=" << counters.peakCapacityBytes
+            << " wasted_bytes=" << counters.wastedBytesAtDestruction << '\n';
+    }
+}
+
+inline vector_stats::vector_stats(vector_stats&& other) noexcept
+    : site_ { std::exchange(other.site_, untaggedSite) }
+    , counters_ { std::exchange(other.counters_, {}) }
+{
+}
+
+inline vector_stats& vector_stats::operator=(vector_stats&& other) noexcept
+{
+    if (this != &other) {
+        site_ = std::exchange(other.site_, untaggedSite);
+        counters_ = std::exchange(other.counters_, {});
+    }
+    return *this;
+}
+
+inline void vector_stats::tag(const std::source_location location)
+{
+    site_ = std::string { location.file_name() } + ':' + std::to_string(location.line()) + ' ' + location.function_name();
+}
+
+inline void vector_stats::on_allocate(std::size_t capacityBytes) noexcept
+{
+    ++counters_.allocations;
+    counters_.peakCapacityBytes = std::max(counters_.peakCapacityBytes, capacityBytes);
+}
+
+inline void vector_stats::on_reallocate(std::size_t bytesMoved) noexcept
+{
+    ++counters_.reallocations;
+    counters_.bytesMoved += bytesMoved;
+}
+
+inline void vector_stats::on_destroy(std::size_t sizeBytes, std::size_t capacityBytes) noexcept
+{
+    if (site_ == untaggedSite || counters_.allocations == 0) {
+        return;
+    }
+    counters_.instances = 1;
+    counters_.wastedBytesAtDestruction = capacityBytes - sizeBytes;
+    try {
+        stats_registry::instance().record(site_, counters_);
+    } catch (...) {
+        // Statistics are best effort, failing to record them must not break destruction of vector.
+    }
+}
+}
@@ -4,6 +4,7 @@
 #include <numeric>
 #include <iomanip>
 #include <cassert>
+#include <vector>
 
 #include "vector.hpp"
 
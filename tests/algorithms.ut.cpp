@@ -0,0 +1,151 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <string>
+
+#include "algorithms.hpp"
+
+constexpr std::size_t algorithmsVectorSize = 10'000;
+
+template <typename T>
+my_vec::vector<T> makeRandomVector(std::size_t size, std::uint32_t seed = 42)
+{
+    std::mt19937_64 engine { seed };
+    my_vec::vector<T> vec;
+    vec.reserve(size);
+    for (std::size_t i = 0; i < size; ++i) {
+        if constexpr (std::is_floating_point_v<T>) {
+            vec.push_back(std::uniform_real_distribution<T> { -1000, 1000 }(engine));
+        } else {
+            vec.push_back(static_cast<T>(engine()));
+        }
+    }
+    return vec;
+}
+
+template <typename T>
+class AlgorithmsTest : public ::testing::Test {
+};
+
+using ArithmeticTypes = ::testing::Types<std::int8_t, std::uint8_t, std::int16_t, std::uint16_t, std::int32_t, std::uint32_t, std::int64_t, std::uint64_t, float, double>;
+TYPED_TEST_SUITE(AlgorithmsTest, ArithmeticTypes);
+
+TYPED_TEST(AlgorithmsTest, SortShouldOrderElementsLikeStdSort)
+{
+    for (const auto size : { std::size_t { 0 }, std::size_t { 1 }, std::size_t { 100 }, algorithmsVectorSize }) {
+        auto vec = makeRandomVector<TypeParam>(size);
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+
+        my_vec::algorithms::sort(vec);
+
+        EXPECT_EQ(vec, expected) << "size " << size;
+    }
+}
+
+TYPED_TEST(AlgorithmsTest, LowerBoundShouldMatchStdLowerBound)
+{
+    auto vec = makeRandomVector<TypeParam>(algorithmsVectorSize);
+    std::sort(vec.begin(), vec.end());
+    const auto probes = makeRandomVector<TypeParam>(1000, 7);
+
+    for (const auto& value : vec) {
+        EXPECT_EQ(my_vec::algorithms::lower_bound(vec, value), std::lower_bound(vec.begin(), vec.end(), value));
+    }
+    for (const auto& value : probes) {
+        EXPECT_EQ(my_vec::algorithms::lower_bound(vec, value), std::lower_bound(vec.begin(), vec.end(), value));
+    }
+}
+
+TYPED_TEST(AlgorithmsTest, FindAndCountShouldMatchStdAlgorithmsForEveryTailLength)
+{
+    for (std::size_t size = 0; size <= 100; ++size) {
+        my_vec::vector<TypeParam> vec;
+        for (std::size_t i = 0; i < size; ++i) {
+            vec.push_back(static_cast<TypeParam>(i % 7));
+        }
+        for (const auto value : { TypeParam { 0 }, TypeParam { 3 }, TypeParam { 6 }, TypeParam { 9 } }) {
+            EXPECT_EQ(my_vec::algorithms::find(vec, value), std::find(vec.begin(), vec.end(), value));
+            EXPECT_EQ(my_vec::algorithms::count(vec, value), static_cast<std::size_t>(std::count(vec.begin(), vec.end(), value)));
+        }
+    }
+}
+
+TYPED_TEST(AlgorithmsTest, MinMaxShouldMatchStdMinMaxForEveryTailLength)
+{
+    const auto source = makeRandomVector<TypeParam>(100);
+    for (std::size_t size = 1; size <= source.size(); ++size) {
+        const my_vec::vector<TypeParam> vec(source.begin(), source.begin() + size);
+
+        const auto [minimum, maximum] = my_vec::algorithms::min_max(vec);
+        const auto [expectedMinimum, expectedMaximum] = std::minmax_element(vec.begin(), vec.end());
+
+        EXPECT_EQ(minimum, *expectedMinimum) << "size " << size;
+        EXPECT_EQ(maximum, *expectedMaximum) << "size " << size;
+    }
+}
+
+TEST(Algorithms, SortShouldPlaceNegativeFloatsBeforePositiveAndInfinitiesAtEnds)
+{
+    constexpr auto infinity = std::numeric_limits<float>::infinity();
+    my_vec::vector<float> vec;
+    for (std::size_t i = 0; i < my_vec::algorithms::detail::radixSortThreshold; ++i) {
+        vec.push_back(static_cast<float>(i) - 100.5F);
+    }
+    vec.push_back(infinity);
+    vec.push_back(-infinity);
+    vec.push_back(std::numeric_limits<float>::denorm_min());
+    vec.push_back(-std::numeric_limits<float>::denorm_min());
+
+    my_vec::algorithms::sort(vec);
+
+    EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+    EXPECT_EQ(vec.front(), -infinity);
+    EXPECT_EQ(vec.back(), infinity);
+}
+
+TEST(Algorithms, SortShouldFallBackToStdSortForNonArithmeticElements)
+{
+    my_vec::vector<std::string> vec { "delta", "alpha", "charlie", "bravo" };
+
+    my_vec::algorithms::sort(vec);
+
+    EXPECT_EQ(vec, (my_vec::vector<std::string> { "alpha", "bravo", "charlie", "delta" }));
+}
+
+TEST(Algorithms, LowerBoundShouldUseGivenComparator)
+{
+    const my_vec::vector<int> vec { 9, 7, 5, 3, 1 };
+
+    const auto it = my_vec::algorithms::lower_bound(vec, 4, std::greater<> {});
+
+    EXPECT_EQ(it, vec.begin() + 3);
+}
+
+TEST(Algorithms, LowerBoundOfEmptyVectorShouldReturnEnd)
+{
+    my_vec::vector<int> vec;
+
+    EXPECT_EQ(my_vec::algorithms::lower_bound(vec, 1), vec.end());
+}
+
+#if defined(__x86_64__) && defined(__GNUC__)
+TEST(Algorithms, Avx2KernelsShouldMatchScalarKernels)
+{
+    if (!my_vec::algorithms::detail::hasAvx2()) {
+        GTEST_SKIP() << "CPU does not support AVX2";
+    }
+    const auto vec = makeRandomVector<std::int32_t>(algorithmsVectorSize);
+    const auto value = vec[algorithmsVectorSize / 2];
+    namespace detail = my_vec::algorithms::detail;
+
+    EXPECT_EQ(detail::findAvx2(vec.data(), vec.size(), value), static_cast<std::size_t>(std::find(vec.begin(), vec.end(), value) - vec.begin()));
+    EXPECT_EQ(detail::countAvx2(vec.data(), vec.size(), value), static_cast<std::size_t>(std::count(vec.begin(), vec.end(), value)));
+    const auto [minimum, maximum] = detail::minMaxAvx2(vec.data(), vec.size());
+    EXPECT_EQ(minimum, *std::min_element(vec.begin(), vec.end()));
+    EXPECT_EQ(maximum, *std::max_element(vec.begin(), vec.end()));
+}
+#endif
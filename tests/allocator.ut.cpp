@@ -54,3 +54,28 @@ TEST(Allocator, AllocatorShouldAllocateMemoryToInitializeItUsingConstruct)
     EXPECT_EQ(0, allocatedSpace[0].getCounter());
     allocator.deallocate(allocatedSpace, numOfElems);
 }
+
+constexpr int sumOfConstantEvaluatedAllocation()
+{
+    constexpr std::size_t numOfElems = 4;
+    my_alloc::allocator<int> allocator;
+
+    int* allocatedSpace = allocator.allocate(numOfElems);
+    for (std::size_t i = 0; i != numOfElems; ++i) {
+        std::construct_at(&allocatedSpace[i], baseTestValue);
+    }
+
+    int total = 0;
+    for (std::size_t i = 0; i != numOfElems; ++i) {
+        total += allocatedSpace[i];
+    }
+    std::destroy_n(allocatedSpace, numOfElems);
+    allocator.deallocate(allocatedSpace, numOfElems);
+    return total;
+}
+
+TEST(Allocator, AllocatorShouldBeUsableInConstantEvaluation)
+{
+    static_assert(sumOfConstantEvaluatedAllocation() == 4 * baseTestValue);
+    EXPECT_EQ(sumOfConstantEvaluatedAllocation(), 4 * baseTestValue);
+}
@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "concurrent_vector.hpp"
+
+constexpr std::size_t numOfThreads = 8;
+constexpr std::size_t elementsPerThread = 10000;
+
+TEST(ConcurrentVector, DefaultConstructorShouldCreateEmptyConcurrentVector)
+{
+    my_vec::concurrent_vector<int> vec;
+
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.size(), 0);
+    EXPECT_EQ(vec.capacity(), 0);
+}
+
+TEST(ConcurrentVector, PushBackShouldReturnIndexOfAddedElement)
+{
+    my_vec::concurrent_vector<std::string> vec;
+
+    EXPECT_EQ(vec.push_back("first"), 0);
+    EXPECT_EQ(vec.emplace_back(3, 'x'), 1);
+
+    EXPECT_EQ(vec.size(), 2);
+    EXPECT_EQ(vec[0], "first");
+    EXPECT_EQ(vec[1], "xxx");
+}
+
+TEST(ConcurrentVector, GrowthShouldNotInvalidateReferencesToElements)
+{
+    constexpr int firstValue = 42;
+    my_vec::concurrent_vector<int> vec;
+    vec.push_back(firstValue);
+    const int* firstElement = &vec[0];
+
+    for (int i = 1; i < 1000; ++i) {
+        vec.push_back(i);
+    }
+
+    EXPECT_EQ(firstElement, &vec[0]);
+    EXPECT_EQ(*firstElement, firstValue);
+    EXPECT_GE(vec.capacity(), vec.size());
+    for (int i = 1; i < 1000; ++i) {
+        EXPECT_EQ(vec[static_cast<std::size_t>(i)], i);
+    }
+}
+
+TEST(ConcurrentVector, AtShouldThrowExceptionWhenPositionIsNotWithinRangeOfContainer)
+{
+    my_vec::concurrent_vector<int> vec;
+    vec.push_back(1);
+
+    EXPECT_EQ(vec.at(0), 1);
+    EXPECT_THROW(vec.at(1), std::out_of_range);
+}
+
+namespace {
+struct counted {
+    static inline int live = 0;
+    explicit counted(bool shouldThrow)
+    {
+        if (shouldThrow) {
+            throw std::runtime_error { "construction failed" };
+        }
+        ++live;
+    }
+    counted(const counted&) = delete;
+    ~counted() { --live; }
+};
+
+template <typename T>
+struct failing_segment_allocator : my_alloc::allocator<T> {
+    static inline bool failNextAllocation = false;
+    failing_segment_allocator() noexcept = default;
+    template <typename U>
+    failing_segment_allocator(const failing_segment_allocator<U>&) noexcept
+    {
+    }
+    T* allocate(std::size_t n)
+    {
+        if (std::exchange(failNextAllocation, false)) {
+            throw std::bad_alloc {};
+        }
+        return my_alloc::allocator<T>::allocate(n);
+    }
+};
+}
+
+TEST(ConcurrentVector, ThrowingConstructionShouldLeaveClaimedSlotEmpty)
+{
+    {
+        my_vec::concurrent_vector<counted> vec;
+        vec.emplace_back(false);
+        EXPECT_THROW(vec.emplace_back(true), std::runtime_error);
+        EXPECT_EQ(vec.emplace_back(false), 2);
+
+        EXPECT_EQ(vec.size(), 3);
+        EXPECT_EQ(counted::live, 2);
+        EXPECT_NO_THROW(static_cast<void>(vec.at(2)));
+        EXPECT_THROW(static_cast<void>(vec.at(1)), std::out_of_range);
+    }
+    EXPECT_EQ(counted::live, 0);
+}
+
+TEST(ConcurrentVector, ThrowingSegmentAllocationShouldLeaveClaimedSlotEmpty)
+{
+    my_vec::concurrent_vector<int, failing_segment_allocator<int>> vec;
+    for (int i = 0; i < static_cast<int>(vec.firstSegmentSize); ++i) {
+        vec.push_back(i);
+    }
+
+    failing_segment_allocator<int>::failNextAllocation = true;
+    EXPECT_THROW(vec.push_back(-1), std::bad_alloc);
+    const auto pos = vec.push_back(1);
+
+    EXPECT_EQ(pos, vec.firstSegmentSize + 1);
+    EXPECT_EQ(vec.at(pos), 1);
+    EXPECT_THROW(static_cast<void>(vec.at(vec.firstSegmentSize)), std::out_of_range);
+}
+
+TEST(ConcurrentVector, ConcurrentPushBackShouldStoreEveryElementExactlyOnce)
+{
+    my_vec::concurrent_vector<std::size_t> vec;
+
+    std::vector<std::thread> producers;
+    for (std::size_t t = 0; t < numOfThreads; ++t) {
+        producers.emplace_back([&vec, t] {
+            for (std::size_t i = 0; i < elementsPerThread; ++i) {
+                const auto index = vec.push_back(t * elementsPerThread + i);
+                EXPECT_EQ(vec[index], t * elementsPerThread + i);
+            }
+        });
+    }
+    for (auto& producer : producers) {
+        producer.join();
+    }
+
+    ASSERT_EQ(vec.size(), numOfThreads * elementsPerThread);
+    std::vector<std::size_t> values;
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        values.push_back(vec[i]);
+    }
+    std::sort(values.begin(), values.end());
+    for (std::size_t i = 0; i < values.size(); ++i) {
+        EXPECT_EQ(values[i], i);
+    }
+}
@@ -0,0 +1,132 @@
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cow_vector.hpp"
+#include "tracking_allocator.hpp"
+
+constexpr std::size_t cowVectorSize = 1000;
+constexpr std::size_t cowVectorCopies = 64;
+
+TEST(CowVectorTest, CopiesShouldShareBufferUntilMutation)
+{
+    const my_vec::cow_vector<int> original { 1, 2, 3 };
+    my_vec::cow_vector<int> copy = original;
+
+    EXPECT_EQ(original.use_count(), 2);
+    EXPECT_EQ(std::as_const(copy).data(), original.data());
+
+    copy.push_back(4);
+
+    EXPECT_EQ(original.use_count(), 1);
+    EXPECT_EQ(copy.use_count(), 1);
+    EXPECT_EQ(original, (my_vec::cow_vector<int> { 1, 2, 3 }));
+    EXPECT_EQ(copy, (my_vec::cow_vector<int> { 1, 2, 3, 4 }));
+}
+
+TEST(CowVectorTest, NonConstAccessShouldUnshareBuffer)
+{
+    const my_vec::cow_vector<std::string> original { "a", "b" };
+    auto copy = original;
+
+    copy[0] = "changed";
+
+    EXPECT_EQ(original[0], "a");
+    EXPECT_EQ(copy[0], "changed");
+    EXPECT_THROW(static_cast<void>(copy.at(2)), std::out_of_range);
+}
+
+TEST(CowVectorTest, UnshareShouldCopyOnlySharedBuffer)
+{
+    my_vec::cow_vector<int> vec { 1, 2, 3 };
+    const int* data = std::as_const(vec).data();
+
+    vec.unshare();
+    EXPECT_EQ(std::as_const(vec).data(), data);
+
+    const auto copy = vec;
+    vec.unshare();
+    EXPECT_NE(std::as_const(vec).data(), data);
+    EXPECT_EQ(copy.data(), data);
+}
+
+TEST(CowVectorTest, InsertAndEraseShouldAcceptIteratorsIntoSharedBuffer)
+{
+    my_vec::cow_vector<int> vec { 1, 2, 4 };
+    const auto copy = vec;
+
+    auto it = vec.insert(std::as_const(vec).begin() + 2, 3);
+    EXPECT_EQ(*it, 3);
+    const auto second = vec;
+    it = vec.erase(std::as_const(vec).begin());
+    EXPECT_EQ(*it, 2);
+
+    EXPECT_EQ(vec, (my_vec::cow_vector<int> { 2, 3, 4 }));
+    EXPECT_EQ(second, (my_vec::cow_vector<int> { 1, 2, 3, 4 }));
+    EXPECT_EQ(copy, (my_vec::cow_vector<int> { 1, 2, 4 }));
+}
+
+TEST(CowVectorTest, ClearOfSharedBufferShouldDropReferenceAndMoveShouldLeaveEmptyVector)
+{
+    my_vec::cow_vector<int> vec { 1, 2, 3 };
+    auto copy = vec;
+
+    vec.clear();
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.use_count(), 0);
+    EXPECT_EQ(copy.size(), 3);
+
+    auto moved = std::move(copy);
+    EXPECT_TRUE(copy.empty());
+    EXPECT_EQ(moved.use_count(), 1);
+    copy.push_back(5);
+    EXPECT_EQ(copy, (my_vec::cow_vector<int> { 5 }));
+}
+
+TEST(CowVectorTest, CopiesShouldNotAllocateUntilMutation)
+{
+    using tracked_allocator = my_alloc::tracking_allocator<my_alloc::allocator<std::size_t>>;
+    auto& registry = my_alloc::tracking_registry::instance();
+    {
+        my_vec::cow_vector<std::size_t, tracked_allocator> vec(cowVectorSize, 7);
+        registry.reset();
+
+        std::vector<my_vec::cow_vector<std::size_t, tracked_allocator>> copies(cowVectorCopies, vec);
+        EXPECT_EQ(registry.snapshot().allocations, 0);
+        EXPECT_EQ(vec.use_count(), cowVectorCopies + 1);
+
+        copies.front().push_back(8);
+        EXPECT_GT(registry.snapshot().allocations, 0);
+    }
+    registry.reset();
+}
+
+TEST(CowVectorTest, CopiesShouldBeMutableFromDifferentThreads)
+{
+    const my_vec::cow_vector<std::size_t> original(cowVectorSize, 0);
+
+    std::vector<std::thread> threads;
+    std::vector<my_vec::cow_vector<std::size_t>> results(8);
+    for (std::size_t t = 0; t < results.size(); ++t) {
+        threads.emplace_back([&original, &results, t] {
+            for (std::size_t i = 0; i < cowVectorCopies; ++i) {
+                auto copy = original;
+                copy[0] = t;
+                results[t] = copy;
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    EXPECT_EQ(original.use_count(), 1);
+    EXPECT_EQ(original[0], 0);
+    for (std::size_t t = 0; t < results.size(); ++t) {
+        EXPECT_EQ(results[t][0], t);
+        EXPECT_EQ(results[t].use_count(), 1);
+    }
+}
@@ -0,0 +1,133 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "flat_map.hpp"
+
+constexpr std::size_t flatMapSize = 1000;
+
+TEST(FlatMapTest, ConstructorShouldSortEntriesAndKeepFirstOfEquivalentKeys)
+{
+    const my_vec::flat_map<int, std::string> map(my_vec::vector<int> { 3, 1, 3, 2 }, my_vec::vector<std::string> { "c", "a", "C", "b" });
+
+    EXPECT_EQ(map.keys(), (my_vec::vector<int> { 1, 2, 3 }));
+    EXPECT_EQ(map.values(), (my_vec::vector<std::string> { "a", "b", "c" }));
+}
+
+TEST(FlatMapTest, ConstructorShouldThrowWhenKeysAndValuesDifferInSize)
+{
+    EXPECT_THROW((my_vec::flat_map<int, int>(my_vec::vector<int> { 1, 2 }, my_vec::vector<int> { 1 })), std::invalid_argument);
+}
+
+TEST(FlatMapTest, IteratorsShouldPairKeysWithMutableValues)
+{
+    my_vec::flat_map<std::string, int> map { { "b", 2 }, { "a", 1 } };
+
+    for (auto [key, value] : map) {
+        value *= 10;
+    }
+    map.begin()->second += 1;
+
+    EXPECT_EQ(map.begin()->first, "a");
+    EXPECT_EQ(map.at("a"), 11);
+    EXPECT_EQ(map.at("b"), 20);
+    EXPECT_EQ(map.end() - map.begin(), 2);
+}
+
+TEST(FlatMapTest, SubscriptShouldInsertValueInitializedEntry)
+{
+    my_vec::flat_map<int, int> map;
+
+    map[5] += 3;
+    map[1] = 7;
+    map[5] += 1;
+
+    EXPECT_EQ(map.keys(), (my_vec::vector<int> { 1, 5 }));
+    EXPECT_EQ(map.values(), (my_vec::vector<int> { 7, 4 }));
+}
+
+TEST(FlatMapTest, InsertShouldNotOverwriteButInsertOrAssignShould)
+{
+    my_vec::flat_map<int, std::string> map;
+
+    EXPECT_TRUE(map.insert({ 1, "one" }).second);
+    EXPECT_FALSE(map.insert({ 1, "uno" }).second);
+    EXPECT_EQ(map.at(1), "one");
+    EXPECT_FALSE(map.insert_or_assign(1, "uno").second);
+    EXPECT_EQ(map.at(1), "uno");
+    EXPECT_TRUE(map.try_emplace(2, 3, 'x').second);
+    EXPECT_EQ(map.at(2), "xxx");
+}
+
+TEST(FlatMapTest, TryEmplaceShouldAcceptMoveOnlyValues)
+{
+    my_vec::flat_map<int, std::unique_ptr<int>> map;
+
+    map.try_emplace(2, std::make_unique<int>(20));
+    map.try_emplace(1, std::make_unique<int>(10));
+
+    EXPECT_EQ(*map.at(1), 10);
+    EXPECT_EQ(*map.find(2)->second, 20);
+}
+
+TEST(FlatMapTest, InsertRangeShouldMergeBatchLikeStdMapInsert)
+{
+    my_vec::flat_map<int, std::size_t> map;
+    std::map<int, std::size_t> expected;
+    for (std::size_t batch = 0; batch < 3; ++batch) {
+        my_vec::vector<std::pair<int, std::size_t>> entries;
+        for (std::size_t i = 0; i < flatMapSize; ++i) {
+            entries.push_back({ static_cast<int>((i * 7 + batch * 13) % flatMapSize), batch });
+        }
+
+        map.insert_range(entries);
+        expected.insert(entries.begin(), entries.end());
+    }
+
+    ASSERT_EQ(map.size(), expected.size());
+    EXPECT_TRUE(std::equal(map.begin(), map.end(), expected.begin(), expected.end(), [](const auto& lhs, const auto& rhs) {
+        return lhs.first == rhs.first && lhs.second == rhs.second;
+    }));
+}
+
+TEST(FlatMapTest, InsertRangeShouldCopyFromLvalueRange)
+{
+    my_vec::vector<std::pair<std::string, std::string>> entries { { "k", "v" } };
+    my_vec::flat_map<std::string, std::string> map;
+
+    map.insert_range(entries);
+
+    EXPECT_EQ(entries[0].first, "k");
+    EXPECT_EQ(entries[0].second, "v");
+    EXPECT_EQ(map.at("k"), "v");
+}
+
+TEST(FlatMapTest, LookupsAndEraseShouldKeepKeysAndValuesAligned)
+{
+    my_vec::flat_map<int, char> map { { 30, 'c' }, { 10, 'a' }, { 20, 'b' } };
+
+    EXPECT_EQ(map.lower_bound(15)->second, 'b');
+    EXPECT_EQ(map.upper_bound(20)->second, 'c');
+    EXPECT_EQ(map.find(25), map.end());
+    EXPECT_EQ(map.erase(20), 1);
+    EXPECT_EQ(map.erase(20), 0);
+    EXPECT_THROW(map.at(20), std::out_of_range);
+    EXPECT_EQ(map.keys(), (my_vec::vector<int> { 10, 30 }));
+    EXPECT_EQ(map.values(), (my_vec::vector<char> { 'a', 'c' }));
+}
+
+TEST(FlatMapTest, ExtractShouldReturnContainersAndLeaveMapEmpty)
+{
+    my_vec::flat_map<int, int> map { { 2, 4 }, { 1, 2 } };
+
+    auto [keys, values] = std::move(map).extract();
+
+    EXPECT_EQ(keys, (my_vec::vector<int> { 1, 2 }));
+    EXPECT_EQ(values, (my_vec::vector<int> { 2, 4 }));
+    EXPECT_TRUE(map.empty());
+}
@@ -0,0 +1,144 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <random>
+#include <set>
+#include <string>
+
+#include "flat_set.hpp"
+
+constexpr std::size_t flatSetSize = 1000;
+
+my_vec::vector<int> makeShuffledKeysWithDuplicates(std::size_t size)
+{
+    my_vec::vector<int> keys;
+    for (std::size_t i = 0; i < size; ++i) {
+        keys.push_back(static_cast<int>(i / 2));
+    }
+    std::shuffle(keys.begin(), keys.end(), std::mt19937 { 42 });
+    return keys;
+}
+
+TEST(FlatSetTest, ConstructorShouldSortAndDeduplicateKeys)
+{
+    const my_vec::flat_set<int> set(makeShuffledKeysWithDuplicates(flatSetSize));
+
+    ASSERT_EQ(set.size(), flatSetSize / 2);
+    EXPECT_TRUE(std::is_sorted(set.begin(), set.end()));
+    EXPECT_EQ(std::adjacent_find(set.begin(), set.end()), set.end());
+}
+
+TEST(FlatSetTest, ConstructorShouldUseGivenComparator)
+{
+    const my_vec::flat_set<int, std::greater<int>> set { 1, 5, 3, 5, 2 };
+
+    EXPECT_EQ(std::vector<int>(set.begin(), set.end()), (std::vector<int> { 5, 3, 2, 1 }));
+}
+
+TEST(FlatSetTest, InsertShouldKeepKeysSortedAndRejectDuplicates)
+{
+    my_vec::flat_set<std::string> set;
+
+    EXPECT_TRUE(set.insert("delta").second);
+    EXPECT_TRUE(set.insert("alpha").second);
+    const auto [it, inserted] = set.insert("delta");
+
+    EXPECT_FALSE(inserted);
+    EXPECT_EQ(*it, "delta");
+    EXPECT_EQ(std::vector<std::string>(set.begin(), set.end()), (std::vector<std::string> { "alpha", "delta" }));
+}
+
+TEST(FlatSetTest, InsertRangeShouldMergeBatchLikeStdSet)
+{
+    auto firstBatch = makeShuffledKeysWithDuplicates(flatSetSize);
+    my_vec::vector<int> secondBatch;
+    for (std::size_t i = 0; i < flatSetSize; ++i) {
+        secondBatch.push_back(static_cast<int>(i * 3 % flatSetSize));
+    }
+    my_vec::flat_set<int> set;
+    std::set<int> expected;
+
+    set.insert_range(firstBatch);
+    set.insert_range(secondBatch);
+    expected.insert(firstBatch.begin(), firstBatch.end());
+    expected.insert(secondBatch.begin(), secondBatch.end());
+
+    EXPECT_TRUE(std::equal(set.begin(), set.end(), expected.begin(), expected.end()));
+}
+
+TEST(FlatSetTest, InsertRangeOfGreaterKeysShouldAppendWithoutReallocatingTwice)
+{
+    my_vec::flat_set<int> set { 1, 2, 3 };
+
+    set.insert_range(my_vec::vector<int> { 6, 5, 4, 5 });
+
+    EXPECT_EQ(std::move(set).extract(), (my_vec::vector<int> { 1, 2, 3, 4, 5, 6 }));
+}
+
+TEST(FlatSetTest, LookupsShouldFindOnlyStoredKeys)
+{
+    const my_vec::flat_set<int> set { 10, 20, 30 };
+
+    EXPECT_TRUE(set.contains(20));
+    EXPECT_FALSE(set.contains(25));
+    EXPECT_EQ(set.count(30), 1);
+    EXPECT_EQ(set.find(15), set.end());
+    EXPECT_EQ(*set.lower_bound(15), 20);
+    EXPECT_EQ(*set.upper_bound(20), 30);
+    const auto [first, last] = set.equal_range(10);
+    EXPECT_EQ(std::distance(first, last), 1);
+}
+
+TEST(FlatSetTest, EraseShouldRemoveKeyAndReportCount)
+{
+    my_vec::flat_set<int> set { 1, 2, 3 };
+
+    EXPECT_EQ(set.erase(2), 1);
+    EXPECT_EQ(set.erase(2), 0);
+    const auto it = set.erase(set.begin());
+
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(set.size(), 1);
+}
+
+TEST(FlatSetTest, ReplaceShouldAdoptSortedContainer)
+{
+    my_vec::flat_set<int> set { 7 };
+
+    set.replace(my_vec::vector<int> { 1, 2, 3 });
+
+    EXPECT_EQ(set, (my_vec::flat_set<int> { my_vec::sorted_unique, my_vec::vector<int> { 1, 2, 3 } }));
+}
+
+TEST(EytzingerSetTest, LowerBoundAndFindShouldMatchSortedSearch)
+{
+    for (const auto size : { std::size_t { 0 }, std::size_t { 1 }, std::size_t { 2 }, std::size_t { 7 }, std::size_t { 8 }, flatSetSize }) {
+        my_vec::vector<int> keys;
+        for (std::size_t i = 0; i < size; ++i) {
+            keys.push_back(static_cast<int>(2 * i));
+        }
+        const my_vec::eytzinger_set<int> set(keys);
+
+        ASSERT_EQ(set.size(), size);
+        for (int probe = -1; probe <= static_cast<int>(2 * size); ++probe) {
+            const auto expected = std::lower_bound(keys.begin(), keys.end(), probe);
+            const auto it = set.lower_bound(probe);
+            if (expected == keys.end()) {
+                EXPECT_EQ(it, set.end()) << "size " << size << ", probe " << probe;
+            } else {
+                ASSERT_NE(it, set.end()) << "size " << size << ", probe " << probe;
+                EXPECT_EQ(*it, *expected);
+            }
+            EXPECT_EQ(set.contains(probe), probe >= 0 && probe % 2 == 0 && probe < static_cast<int>(2 * size));
+        }
+    }
+}
+
+TEST(EytzingerSetTest, ConstructorShouldDeduplicateAndLayOutKeysBreadthFirst)
+{
+    const my_vec::flat_set<int> sorted(makeShuffledKeysWithDuplicates(14));
+    const my_vec::eytzinger_set<int> set(sorted);
+
+    EXPECT_EQ(std::vector<int>(set.begin(), set.end()), (std::vector<int> { 3, 1, 5, 0, 2, 4, 6 }));
+}
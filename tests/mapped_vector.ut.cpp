@@ -0,0 +1,154 @@
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <numeric>
+#include <string>
+
+#include "mapped_vector.hpp"
+
+constexpr std::size_t mappedVectorSize = 10000;
+
+struct Record {
+    std::uint32_t id;
+    double value;
+};
+
+class MappedVectorTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        path_ = (std::filesystem::temp_directory_path() / ("mapped_vector_" + std::to_string(::getpid()) + ".bin")).string();
+        std::filesystem::remove(path_);
+    }
+
+    void TearDown() override
+    {
+        std::filesystem::remove(path_);
+    }
+
+    void writeRecords(std::size_t count)
+    {
+        my_vec::mapped_vector<Record> vec(path_);
+        for (std::size_t i = 0; i < count; ++i) {
+            vec.push_back({ static_cast<std::uint32_t>(i), static_cast<double>(i) / 2 });
+        }
+    }
+
+    std::string path_;
+};
+
+TEST_F(MappedVectorTest, NewFileShouldCreateEmptyMappedVector)
+{
+    my_vec::mapped_vector<int> vec(path_);
+
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.capacity(), 0);
+    EXPECT_EQ(vec.begin(), vec.end());
+}
+
+TEST_F(MappedVectorTest, ElementsShouldPersistAfterReopeningFile)
+{
+    writeRecords(mappedVectorSize);
+
+    EXPECT_EQ(std::filesystem::file_size(path_), mappedVectorSize * sizeof(Record));
+
+    my_vec::mapped_vector<Record> vec(path_);
+    ASSERT_EQ(vec.size(), mappedVectorSize);
+    EXPECT_EQ(vec.capacity(), mappedVectorSize);
+    std::size_t index = 0;
+    for (const auto& record : vec) {
+        EXPECT_EQ(record.id, index);
+        EXPECT_EQ(record.value, static_cast<double>(index) / 2);
+        ++index;
+    }
+}
+
+TEST_F(MappedVectorTest, ResizeShouldGrowFileAndSetGivenValueForNewElements)
+{
+    constexpr int givenValue = 7;
+    {
+        my_vec::mapped_vector<int> vec(path_);
+        vec.resize(mappedVectorSize, givenValue);
+        vec.sync();
+    }
+
+    my_vec::mapped_vector<int> vec(path_, my_vec::map_mode::read_only);
+    EXPECT_EQ(std::accumulate(vec.begin(), vec.end(), 0), givenValue * static_cast<int>(mappedVectorSize));
+}
+
+TEST_F(MappedVectorTest, FileReopenedAfterSyncShouldHoldOnlyElementsOfLiveVector)
+{
+    my_vec::mapped_vector<int> vec(path_);
+    vec.push_back(1);
+    vec.push_back(2);
+    vec.sync();
+
+    // Vector stays alive, as if process crashed right after sync().
+    EXPECT_GT(vec.capacity(), vec.size());
+    EXPECT_EQ(std::filesystem::file_size(path_), 2 * sizeof(int));
+    {
+        my_vec::mapped_vector<int> reopened(path_, my_vec::map_mode::read_only);
+        EXPECT_EQ(reopened.size(), 2);
+        EXPECT_EQ(reopened.back(), 2);
+    }
+
+    vec.push_back(3);
+    vec.resize(5, 4);
+    vec.sync();
+
+    my_vec::mapped_vector<int> reopened(path_, my_vec::map_mode::read_only);
+    ASSERT_EQ(reopened.size(), 5);
+    EXPECT_EQ(reopened[2], 3);
+    EXPECT_EQ(reopened.back(), 4);
+}
+
+TEST_F(MappedVectorTest, GrowingFromOwnElementShouldCopyItBeforeRemapping)
+{
+    writeRecords(mappedVectorSize);
+    my_vec::mapped_vector<Record> vec(path_);
+    ASSERT_EQ(vec.size(), vec.capacity());
+
+    vec.push_back(vec[1]);
+    vec.resize(4 * mappedVectorSize, vec[2]);
+
+    EXPECT_EQ(vec.size(), 4 * mappedVectorSize);
+    EXPECT_EQ(vec[mappedVectorSize].id, 1);
+    EXPECT_EQ(vec.back().id, 2);
+    EXPECT_EQ(vec.back().value, 1.0);
+}
+
+TEST_F(MappedVectorTest, ReadOnlyMappedVectorShouldThrowOnModification)
+{
+    writeRecords(1);
+
+    my_vec::mapped_vector<Record> vec(path_, my_vec::map_mode::read_only);
+
+    EXPECT_EQ(vec.at(0).id, 0);
+    EXPECT_THROW(vec.push_back({}), std::logic_error);
+    EXPECT_THROW(vec.at(1), std::out_of_range);
+}
+
+TEST_F(MappedVectorTest, CopyOnWriteMappedVectorShouldNotModifyFile)
+{
+    constexpr std::uint32_t changedId = 123456;
+    writeRecords(mappedVectorSize);
+
+    {
+        my_vec::mapped_vector<Record> vec(path_, my_vec::map_mode::copy_on_write);
+        vec[0].id = changedId;
+        vec.push_back({ changedId, 0 });
+        EXPECT_EQ(vec.size(), mappedVectorSize + 1);
+        EXPECT_EQ(vec.front().id, changedId);
+        EXPECT_EQ(vec.back().id, changedId);
+    }
+
+    my_vec::mapped_vector<Record> vec(path_, my_vec::map_mode::read_only);
+    EXPECT_EQ(vec.size(), mappedVectorSize);
+    EXPECT_EQ(vec.front().id, 0);
+}
+
+TEST_F(MappedVectorTest, OpeningMissingFileInReadOnlyModeShouldThrow)
+{
+    EXPECT_THROW(my_vec::mapped_vector<int>(path_, my_vec::map_mode::read_only), std::system_error);
+}
@@ -0,0 +1,104 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "numa_allocator.hpp"
+#include "parallel.hpp"
+#include "vector.hpp"
+
+constexpr std::size_t smallBlockSize = 16;
+constexpr std::size_t largeBlockSize = 1 << 20;
+constexpr int numaTestValue = 42;
+
+TEST(NumaAllocator, AllocatorShouldAllocateUsableMemoryForEveryPolicy)
+{
+    for (const auto policy : { my_alloc::numa_policy::local, my_alloc::numa_policy::interleave, my_alloc::numa_policy::first_touch }) {
+        my_alloc::numa_allocator<int> allocator(policy);
+        for (const auto size : { smallBlockSize, largeBlockSize }) {
+            int* allocatedSpace = allocator.allocate(size);
+            ASSERT_NE(allocatedSpace, nullptr);
+
+            std::uninitialized_fill_n(allocatedSpace, size, numaTestValue);
+            EXPECT_EQ(allocatedSpace[0], numaTestValue);
+            EXPECT_EQ(allocatedSpace[size - 1], numaTestValue);
+
+            allocator.deallocate(allocatedSpace, size);
+        }
+    }
+}
+
+TEST(NumaAllocator, AllocateShouldRejectSizeWhoseByteCountOverflows)
+{
+    my_alloc::numa_allocator<int> allocator;
+
+    EXPECT_THROW(static_cast<void>(allocator.allocate(std::numeric_limits<std::size_t>::max() / 2)), std::bad_array_new_length);
+}
+
+#if defined(__linux__)
+// Number of pages of the block which are backed by physical memory.
+std::size_t countResidentPages(void* p, std::size_t bytes)
+{
+    const auto pageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+    std::vector<unsigned char> residency((bytes + pageSize - 1) / pageSize);
+    if (::mincore(p, bytes, residency.data()) != 0) {
+        return 0;
+    }
+    return static_cast<std::size_t>(std::count_if(residency.begin(), residency.end(), [](unsigned char page) { return (page & 1) != 0; }));
+}
+
+TEST(NumaAllocator, LocalPolicyShouldPopulatePagesWhileFirstTouchLeavesThemUntouched)
+{
+    my_alloc::numa_allocator<int> local(my_alloc::numa_policy::local);
+    my_alloc::numa_allocator<int> firstTouch(my_alloc::numa_policy::first_touch);
+    const auto bytes = largeBlockSize * sizeof(int);
+
+    int* populated = local.allocate(largeBlockSize);
+    int* untouched = firstTouch.allocate(largeBlockSize);
+
+    EXPECT_GT(countResidentPages(populated, bytes), 0);
+    EXPECT_EQ(countResidentPages(untouched, bytes), 0);
+    untouched[0] = numaTestValue;
+    // Transparent huge pages may back more than one page on first touch, but never whole block.
+    EXPECT_GT(countResidentPages(untouched, bytes), 0);
+    EXPECT_LT(countResidentPages(untouched, bytes), countResidentPages(populated, bytes));
+
+    local.deallocate(populated, largeBlockSize);
+    firstTouch.deallocate(untouched, largeBlockSize);
+}
+#endif
+
+TEST(NumaAllocator, VectorWithInterleavedAllocatorShouldBehaveLikeDefaultVector)
+{
+    using numa_vector = my_vec::vector<int, my_alloc::numa_allocator<int>>;
+    numa_vector vec(largeBlockSize, numaTestValue, my_alloc::numa_allocator<int>(my_alloc::numa_policy::interleave));
+
+    vec.push_back(numaTestValue + 1);
+    vec.shrink_to_fit();
+
+    EXPECT_EQ(vec.size(), largeBlockSize + 1);
+    EXPECT_EQ(vec.capacity(), largeBlockSize + 1);
+    EXPECT_EQ(vec.front(), numaTestValue);
+    EXPECT_EQ(vec.back(), numaTestValue + 1);
+}
+
+TEST(NumaAllocator, PartitionedFirstTouchConstructionShouldInitializeEveryElement)
+{
+    my_vec::thread_pool pool(4, 1);
+    const my_alloc::numa_allocator<int> allocator(my_alloc::numa_policy::first_touch);
+
+    auto vec = my_vec::parallel::make_vector(largeBlockSize, numaTestValue, allocator, pool);
+
+    EXPECT_EQ(vec.size(), largeBlockSize);
+    for (std::size_t i = 0; i < largeBlockSize; ++i) {
+        ASSERT_EQ(vec[i], numaTestValue);
+    }
+}
@@ -0,0 +1,268 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "numa_allocator.hpp"
+#include "parallel.hpp"
+#include "tracking_allocator.hpp"
+
+constexpr std::size_t numOfWorkers = 4;
+constexpr std::size_t parallelVectorSize = 10000;
+constexpr int parallelValue = 7;
+
+class ParallelTest : public ::testing::Test {
+protected:
+    my_vec::thread_pool pool_ { numOfWorkers, 1 };
+};
+
+class ThrowingOnCopy {
+public:
+    ThrowingOnCopy() { ++alive_; }
+    ThrowingOnCopy(const ThrowingOnCopy&)
+    {
+        if (++copies_ == copiesBeforeThrow_) {
+            throw std::runtime_error { "copy failed" };
+        }
+        ++alive_;
+    }
+    ~ThrowingOnCopy() { --alive_; }
+
+    inline static int alive_ { 0 };
+    inline static int copies_ { 0 };
+    inline static int copiesBeforeThrow_ { 0 };
+};
+
+TEST_F(ParallelTest, MakeVectorShouldConstructVectorWithGivenCountCopiesOfValue)
+{
+    auto vec = my_vec::parallel::make_vector(parallelVectorSize, parallelValue, my_alloc::allocator<int> {}, pool_);
+
+    EXPECT_EQ(vec.size(), parallelVectorSize);
+    EXPECT_EQ(vec.capacity(), parallelVectorSize);
+    for (std::size_t i = 0; i < parallelVectorSize; ++i) {
+        EXPECT_EQ(vec[i], parallelValue);
+    }
+}
+
+TEST_F(ParallelTest, MakeVectorShouldDestroyConstructedElementsWhenCopyThrows)
+{
+    ThrowingOnCopy value;
+    ThrowingOnCopy::copies_ = 0;
+    ThrowingOnCopy::copiesBeforeThrow_ = static_cast<int>(parallelVectorSize / 2);
+
+    EXPECT_THROW(my_vec::parallel::make_vector(parallelVectorSize, value, my_alloc::allocator<ThrowingOnCopy> {}, pool_), std::runtime_error);
+    EXPECT_EQ(ThrowingOnCopy::alive_, 1);
+}
+
+TEST_F(ParallelTest, CopyShouldCreateNewVectorByCopyingGiven)
+{
+    my_vec::vector<std::string> vec(parallelVectorSize, "string");
+
+    auto copy = my_vec::parallel::copy(vec, pool_);
+
+    EXPECT_EQ(copy, vec);
+}
+
+TEST_F(ParallelTest, CopyAndTransformShouldPropagateAllocatorOfSource)
+{
+    using numa_vector = my_vec::vector<int, my_alloc::numa_allocator<int>>;
+    const numa_vector vec(parallelVectorSize, parallelValue, my_alloc::numa_allocator<int>(my_alloc::numa_policy::interleave));
+
+    const auto copy = my_vec::parallel::copy(vec, pool_);
+    const auto result = my_vec::parallel::transform(vec, [](int value) { return static_cast<long>(value) * 2; }, pool_);
+
+    EXPECT_EQ(copy.get_allocator().policy(), my_alloc::numa_policy::interleave);
+    EXPECT_EQ(result.get_allocator().policy(), my_alloc::numa_policy::interleave);
+    EXPECT_EQ(copy, vec);
+    EXPECT_EQ(result[parallelVectorSize - 1], 2 * parallelValue);
+}
+
+TEST_F(ParallelTest, FillShouldAssignValueToEveryElement)
+{
+    my_vec::vector<int> vec(parallelVectorSize);
+
+    my_vec::parallel::fill(vec, parallelValue, pool_);
+
+    for (std::size_t i = 0; i < parallelVectorSize; ++i) {
+        EXPECT_EQ(vec[i], parallelValue);
+    }
+}
+
+TEST_F(ParallelTest, ResizeShouldSetGivenValueForNewElements)
+{
+    constexpr std::size_t vectorSize = 3;
+    my_vec::vector<int> vec(vectorSize, 1);
+
+    my_vec::parallel::resize(vec, parallelVectorSize, parallelValue, pool_);
+
+    EXPECT_EQ(vec.size(), parallelVectorSize);
+    for (std::size_t i = 0; i < vectorSize; ++i) {
+        EXPECT_EQ(vec[i], 1);
+    }
+    for (std::size_t i = vectorSize; i < parallelVectorSize; ++i) {
+        EXPECT_EQ(vec[i], parallelValue);
+    }
+}
+
+TEST_F(ParallelTest, TransformShouldApplyOperationToEveryElement)
+{
+    my_vec::vector<int> vec(parallelVectorSize, parallelValue);
+
+    auto result = my_vec::parallel::transform(vec, [](int value) { return std::to_string(value); }, pool_);
+
+    EXPECT_EQ(result.size(), parallelVectorSize);
+    for (std::size_t i = 0; i < parallelVectorSize; ++i) {
+        EXPECT_EQ(result[i], "7");
+    }
+}
+
+TEST_F(ParallelTest, ReduceShouldFoldElementsInRangeOrder)
+{
+    my_vec::vector<std::string> vec;
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(std::to_string(i % 10));
+    }
+    std::string expected;
+    for (const auto& el : vec) {
+        expected += el;
+    }
+
+    EXPECT_EQ(my_vec::parallel::reduce(vec, std::string {}, std::plus<> {}, pool_), expected);
+    EXPECT_EQ(my_vec::parallel::reduce(my_vec::vector<int>(parallelVectorSize, 1), std::size_t { 0 }, std::plus<> {}, pool_), parallelVectorSize);
+}
+
+TEST_F(ParallelTest, SortShouldOrderElementsLikeStdSort)
+{
+    std::mt19937 engine { 42 };
+    for (const auto size : { std::size_t { 0 }, std::size_t { 1 }, std::size_t { 3 }, std::size_t { 100 }, parallelVectorSize }) {
+        my_vec::vector<int> vec;
+        for (std::size_t i = 0; i < size; ++i) {
+            vec.push_back(static_cast<int>(engine() % 1000));
+        }
+        auto expected = vec;
+        std::sort(expected.begin(), expected.end());
+
+        my_vec::parallel::sort(vec, std::less<> {}, pool_);
+
+        EXPECT_EQ(vec, expected) << "size " << size;
+    }
+}
+
+TEST_F(ParallelTest, SortShouldUseGivenComparatorAndMoveOnlyElements)
+{
+    my_vec::vector<std::unique_ptr<int>> vec;
+    for (std::size_t i = 0; i < parallelVectorSize; ++i) {
+        vec.push_back(std::make_unique<int>(static_cast<int>((i * 7919) % parallelVectorSize)));
+    }
+
+    my_vec::parallel::sort(vec, [](const auto& lhs, const auto& rhs) { return *lhs > *rhs; }, pool_);
+
+    for (std::size_t i = 0; i < parallelVectorSize; ++i) {
+        ASSERT_NE(vec[i], nullptr);
+        EXPECT_EQ(*vec[i], static_cast<int>(parallelVectorSize - 1 - i));
+    }
+}
+
+TEST_F(ParallelTest, SortShouldTakeScratchBufferFromVectorAllocator)
+{
+    using tracked_allocator = my_alloc::tracking_allocator<my_alloc::allocator<std::string>>;
+    auto& registry = my_alloc::tracking_registry::instance();
+    {
+        my_vec::vector<std::string, tracked_allocator> vec;
+        for (std::size_t i = 0; i < parallelVectorSize; ++i) {
+            vec.push_back(std::to_string((i * 7919) % parallelVectorSize));
+        }
+        registry.reset();
+
+        my_vec::parallel::sort(vec, std::less<> {}, pool_);
+
+        EXPECT_TRUE(std::is_sorted(vec.begin(), vec.end()));
+        const auto stats = registry.snapshot();
+        EXPECT_EQ(stats.allocations, 1);
+        EXPECT_EQ(stats.deallocations, 1);
+        EXPECT_EQ(stats.allocatedBytes, parallelVectorSize * sizeof(std::string));
+    }
+    registry.reset();
+}
+
+TEST_F(ParallelTest, SortShouldReleaseScratchBufferWhenComparatorThrowsDuringMerge)
+{
+    using tracked_allocator = my_alloc::tracking_allocator<my_alloc::allocator<std::string>>;
+    auto& registry = my_alloc::tracking_registry::instance();
+    auto makeVector = [] {
+        my_vec::vector<std::string, tracked_allocator> vec;
+        for (std::size_t i = 0; i < parallelVectorSize; ++i) {
+            vec.push_back(std::to_string((i * 7919) % parallelVectorSize));
+        }
+        return vec;
+    };
+    std::atomic<std::size_t> comparisons { 0 };
+    auto vec = makeVector();
+    my_vec::parallel::sort(vec, [&comparisons](const auto& lhs, const auto& rhs) { return ++comparisons, lhs < rhs; }, pool_);
+    // Last comparisons are made by final merge round.
+    const auto throwAt = comparisons.load() - 100;
+
+    vec = makeVector();
+    registry.reset();
+    comparisons = 0;
+    auto throwingLess = [&comparisons, throwAt](const auto& lhs, const auto& rhs) {
+        if (++comparisons == throwAt) {
+            throw std::runtime_error { "comparison failed" };
+        }
+        return lhs < rhs;
+    };
+
+    EXPECT_THROW(my_vec::parallel::sort(vec, throwingLess, pool_), std::runtime_error);
+    EXPECT_EQ(vec.size(), parallelVectorSize);
+    EXPECT_EQ(registry.snapshot().liveBytes, 0);
+    registry.reset();
+}
+
+TEST_F(ParallelTest, InclusiveScanShouldReplaceElementsWithPrefixFolds)
+{
+    my_vec::vector<std::size_t> vec;
+    for (std::size_t i = 0; i < parallelVectorSize; ++i) {
+        vec.push_back(i);
+    }
+
+    my_vec::parallel::inclusive_scan(vec, std::plus<> {}, pool_);
+
+    for (std::size_t i = 0; i < parallelVectorSize; ++i) {
+        EXPECT_EQ(vec[i], i * (i + 1) / 2);
+    }
+}
+
+TEST_F(ParallelTest, ExclusiveScanShouldStartFromInitAndKeepRangeOrder)
+{
+    my_vec::vector<std::string> vec;
+    std::string expected = ">";
+    my_vec::vector<std::string> expectedPrefixes;
+    for (int i = 0; i < 1000; ++i) {
+        vec.push_back(std::to_string(i % 10));
+        expectedPrefixes.push_back(expected);
+        expected += vec.back();
+    }
+
+    my_vec::parallel::exclusive_scan(vec, std::string { ">" }, std::plus<> {}, pool_);
+
+    EXPECT_EQ(vec, expectedPrefixes);
+}
+
+TEST_F(ParallelTest, ScansShouldStayOnCallingThreadBelowSequentialThreshold)
+{
+    pool_.set_sequential_threshold(parallelVectorSize + 1);
+    my_vec::vector<int> inclusive(parallelVectorSize, 1);
+    my_vec::vector<int> exclusive(parallelVectorSize, 1);
+
+    my_vec::parallel::inclusive_scan(inclusive, std::plus<> {}, pool_);
+    my_vec::parallel::exclusive_scan(exclusive, 0, std::plus<> {}, pool_);
+
+    EXPECT_EQ(inclusive.back(), static_cast<int>(parallelVectorSize));
+    EXPECT_EQ(exclusive.front(), 0);
+    EXPECT_EQ(exclusive.back(), static_cast<int>(parallelVectorSize - 1));
+}
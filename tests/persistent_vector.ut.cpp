@@ -0,0 +1,212 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "persistent_vector.hpp"
+#include "tracking_allocator.hpp"
+
+static_assert(std::random_access_iterator<my_vec::persistent_vector<int>::const_iterator>);
+
+// Three levels of branches plus tail, so root grows and shrinks during tests.
+constexpr std::size_t persistentVectorSize = 32 * 32 * 32 + 100;
+
+my_vec::persistent_vector<std::size_t> makeIota(std::size_t size)
+{
+    my_vec::transient_vector<std::size_t> building;
+    for (std::size_t i = 0; i < size; ++i) {
+        building.push_back(i);
+    }
+    return building.persistent();
+}
+
+TEST(PersistentVectorTest, PushBackShouldKeepPreviousVersionUnchanged)
+{
+    my_vec::persistent_vector<std::size_t> vec;
+    std::vector<my_vec::persistent_vector<std::size_t>> versions;
+
+    for (std::size_t i = 0; i < 2000; ++i) {
+        versions.push_back(vec);
+        vec = vec.push_back(i);
+    }
+
+    ASSERT_EQ(vec.size(), 2000);
+    for (std::size_t i = 0; i < versions.size(); i += 97) {
+        ASSERT_EQ(versions[i].size(), i);
+        for (std::size_t j = 0; j < i; ++j) {
+            ASSERT_EQ(versions[i][j], j);
+        }
+    }
+}
+
+TEST(PersistentVectorTest, SetShouldChangeOnlyNewVersion)
+{
+    const auto original = makeIota(persistentVectorSize);
+
+    const auto changedInTree = original.set(1234, 0);
+    const auto changedInTail = changedInTree.set(persistentVectorSize - 1, 0);
+
+    EXPECT_EQ(original[1234], 1234);
+    EXPECT_EQ(original.back(), persistentVectorSize - 1);
+    EXPECT_EQ(changedInTree[1234], 0);
+    EXPECT_EQ(changedInTree.back(), persistentVectorSize - 1);
+    EXPECT_EQ(changedInTail[1234], 0);
+    EXPECT_EQ(changedInTail.back(), 0);
+    EXPECT_EQ(changedInTail[1233], 1233);
+}
+
+TEST(PersistentVectorTest, PopBackShouldShrinkThroughEveryLevelBackToEmpty)
+{
+    auto vec = makeIota(persistentVectorSize);
+    const auto original = vec;
+
+    while (!vec.empty()) {
+        ASSERT_EQ(vec.back(), vec.size() - 1);
+        vec = vec.pop_back();
+    }
+
+    EXPECT_EQ(original.size(), persistentVectorSize);
+    EXPECT_EQ(original, makeIota(persistentVectorSize));
+}
+
+TEST(PersistentVectorTest, PopBackOnEmptyVectorShouldThrow)
+{
+    const my_vec::persistent_vector<std::size_t> vec;
+    my_vec::transient_vector<std::size_t> transient;
+
+    EXPECT_THROW(static_cast<void>(vec.pop_back()), std::out_of_range);
+    EXPECT_THROW(transient.pop_back(), std::out_of_range);
+    EXPECT_THROW(static_cast<void>(vec.push_back(1).pop_back().pop_back()), std::out_of_range);
+}
+
+TEST(PersistentVectorTest, IteratorsShouldVisitElementsInOrder)
+{
+    const auto vec = makeIota(persistentVectorSize);
+
+    std::size_t expected = 0;
+    for (const auto value : vec) {
+        ASSERT_EQ(value, expected++);
+    }
+    EXPECT_EQ(expected, persistentVectorSize);
+    EXPECT_EQ(vec.end() - vec.begin(), static_cast<std::ptrdiff_t>(persistentVectorSize));
+    EXPECT_EQ(*(vec.end() - 1), persistentVectorSize - 1);
+    EXPECT_EQ(vec.begin()[1000], 1000);
+}
+
+TEST(PersistentVectorTest, TransientShouldEditOwnNodesAndLeavePersistentVersionsIntact)
+{
+    const auto original = makeIota(100);
+    auto transient = original.transient();
+
+    for (std::size_t i = 0; i < 100; ++i) {
+        transient.set(i, i * 2);
+    }
+    transient.pop_back();
+    const auto first = transient.persistent();
+    transient.set(0, 42);
+    transient.push_back(7);
+    const auto second = transient.persistent();
+
+    EXPECT_EQ(original, makeIota(100));
+    EXPECT_EQ(first.size(), 99);
+    EXPECT_EQ(first[0], 0);
+    EXPECT_EQ(first[98], 196);
+    EXPECT_EQ(second[0], 42);
+    EXPECT_EQ(second[99], 7);
+    EXPECT_THROW(transient.set(100, 0), std::out_of_range);
+}
+
+TEST(PersistentVectorTest, ConversionFromAndToVectorShouldPreserveElements)
+{
+    my_vec::vector<std::string> values;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        values.push_back(std::to_string(i));
+    }
+
+    const my_vec::persistent_vector<std::string> vec(values);
+
+    EXPECT_EQ(vec.size(), values.size());
+    EXPECT_EQ(vec.at(999), "999");
+    EXPECT_THROW(static_cast<void>(vec.at(1000)), std::out_of_range);
+    EXPECT_EQ(vec.to_vector(), values);
+    EXPECT_EQ(my_vec::persistent_vector<std::string>({ "a", "b" }).to_vector(), (my_vec::vector<std::string> { "a", "b" }));
+}
+
+TEST(PersistentVectorTest, PushBackShouldAcceptReferenceToOwnElement)
+{
+    auto vec = makeIota(32);
+
+    vec = vec.push_back(vec[5]);
+
+    EXPECT_EQ(vec.size(), 33);
+    EXPECT_EQ(vec[32], 5);
+}
+
+TEST(PersistentVectorTest, VersionsShouldShareUnchangedElements)
+{
+    my_vec::persistent_vector<std::shared_ptr<int>> vec;
+    for (int i = 0; i < 1000; ++i) {
+        vec = vec.push_back(std::make_shared<int>(i));
+    }
+    const auto element = vec[10];
+
+    const auto changed = vec.set(900, nullptr);
+
+    EXPECT_EQ(element.use_count(), 2);
+    EXPECT_EQ(changed[10], element);
+}
+
+TEST(PersistentVectorTest, NodesShouldBeAllocatedThroughAllocator)
+{
+    using tracked_allocator = my_alloc::tracking_allocator<my_alloc::allocator<int>>;
+    // 31 leaves under single root branch plus full tail.
+    constexpr std::size_t numOfLeaves = 32;
+    auto& registry = my_alloc::tracking_registry::instance();
+    registry.reset();
+    {
+        my_vec::transient_vector<int, tracked_allocator> building;
+        for (std::size_t i = 0; i < numOfLeaves * 32; ++i) {
+            building.push_back(static_cast<int>(i));
+        }
+        const auto vec = building.persistent();
+
+        // Every leaf is node plus element buffer, root branch is single node.
+        EXPECT_EQ(registry.snapshot().allocations, 2 * numOfLeaves + 1);
+    }
+    EXPECT_EQ(registry.snapshot().liveBytes, 0);
+    registry.reset();
+}
+
+TEST(PersistentVectorTest, RandomOperationsShouldMatchStdVector)
+{
+    std::mt19937 engine { 42 };
+    my_vec::transient_vector<std::size_t> transient;
+    std::vector<std::size_t> expected;
+
+    for (std::size_t i = 0; i < 20'000; ++i) {
+        const auto operation = engine() % 10;
+        if (operation < 6 || expected.empty()) {
+            transient.push_back(i);
+            expected.push_back(i);
+        } else if (operation < 8) {
+            const auto pos = engine() % expected.size();
+            transient.set(pos, i);
+            expected[pos] = i;
+        } else {
+            transient.pop_back();
+            expected.pop_back();
+        }
+        if (i % 1000 == 0) {
+            const auto snapshot = transient.persistent();
+            ASSERT_TRUE(std::equal(snapshot.begin(), snapshot.end(), expected.begin(), expected.end()));
+        }
+    }
+
+    const auto result = transient.persistent();
+    EXPECT_TRUE(std::equal(result.begin(), result.end(), expected.begin(), expected.end()));
+}
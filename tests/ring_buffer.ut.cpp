@@ -0,0 +1,172 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ring_buffer.hpp"
+
+static_assert(std::random_access_iterator<my_vec::ring_buffer<int>::iterator>);
+static_assert(std::random_access_iterator<my_vec::ring_buffer<int>::const_iterator>);
+
+constexpr std::size_t ringBufferOperations = 1000;
+
+TEST(RingBufferTest, CapacityShouldBeRoundedUpToPowerOfTwo)
+{
+    const my_vec::ring_buffer<int> buffer(5);
+
+    EXPECT_EQ(buffer.capacity(), 8);
+    EXPECT_TRUE(buffer.empty());
+}
+
+TEST(RingBufferTest, PushAndPopAtBothEndsShouldBehaveLikeDeque)
+{
+    my_vec::ring_buffer<std::size_t> buffer(4);
+    std::deque<std::size_t> expected;
+
+    for (std::size_t i = 0; i < ringBufferOperations; ++i) {
+        switch (i * 7919 % 5) {
+        case 0:
+        case 1:
+            buffer.push_back(i);
+            expected.push_back(i);
+            break;
+        case 2:
+            buffer.push_front(i);
+            expected.push_front(i);
+            break;
+        case 3:
+            if (!expected.empty()) {
+                buffer.pop_front();
+                expected.pop_front();
+            }
+            break;
+        default:
+            if (!expected.empty()) {
+                buffer.pop_back();
+                expected.pop_back();
+            }
+        }
+        ASSERT_EQ(buffer.size(), expected.size());
+        ASSERT_TRUE(std::equal(buffer.begin(), buffer.end(), expected.begin(), expected.end()));
+    }
+}
+
+TEST(RingBufferTest, FullBufferShouldGrowKeepingOrder)
+{
+    my_vec::ring_buffer<std::string> buffer(2);
+    buffer.push_back("b");
+    buffer.push_front("a");
+
+    buffer.push_back("c");
+    buffer.push_front("z");
+
+    EXPECT_EQ(buffer.capacity(), 4);
+    EXPECT_EQ(std::vector<std::string>(buffer.begin(), buffer.end()), (std::vector<std::string> { "z", "a", "b", "c" }));
+}
+
+TEST(RingBufferTest, GrowingShouldAcceptReferenceToStoredElement)
+{
+    my_vec::ring_buffer<std::string> buffer(1);
+    buffer.push_back(std::string(100, 'x'));
+
+    buffer.push_back(buffer.front());
+
+    EXPECT_EQ(buffer.size(), 2);
+    EXPECT_EQ(buffer.back(), std::string(100, 'x'));
+}
+
+TEST(RingBufferTest, OverwriteOldestShouldKeepCapacityAndDropOppositeEnd)
+{
+    my_vec::ring_buffer<int> buffer(4, my_vec::overwrite_oldest);
+    for (int i = 0; i < 10; ++i) {
+        buffer.push_back(i);
+    }
+
+    EXPECT_EQ(buffer.capacity(), 4);
+    EXPECT_EQ(std::vector<int>(buffer.begin(), buffer.end()), (std::vector<int> { 6, 7, 8, 9 }));
+
+    buffer.push_front(5);
+
+    EXPECT_EQ(std::vector<int>(buffer.begin(), buffer.end()), (std::vector<int> { 5, 6, 7, 8 }));
+}
+
+TEST(RingBufferTest, AsSpansShouldCoverWrappedElementsInOrder)
+{
+    my_vec::ring_buffer<int> buffer(8);
+    for (int i = 0; i < 8; ++i) {
+        buffer.push_back(i);
+    }
+    for (int i = 0; i < 5; ++i) {
+        buffer.pop_front();
+    }
+    for (int i = 8; i < 12; ++i) {
+        buffer.push_back(i);
+    }
+
+    const auto [first, second] = buffer.as_spans();
+    int copied[7];
+    std::memcpy(copied, first.data(), first.size_bytes());
+    std::memcpy(copied + first.size(), second.data(), second.size_bytes());
+
+    EXPECT_EQ(first.size(), 3);
+    EXPECT_EQ(second.size(), 4);
+    EXPECT_TRUE(std::equal(std::begin(copied), std::end(copied), buffer.begin(), buffer.end()));
+}
+
+TEST(RingBufferTest, AsSpansOfContiguousElementsShouldLeaveSecondSpanEmpty)
+{
+    my_vec::ring_buffer<int> buffer(8);
+    buffer.push_back(1);
+    buffer.push_back(2);
+
+    const auto [first, second] = std::as_const(buffer).as_spans();
+
+    EXPECT_EQ(first.size(), 2);
+    EXPECT_TRUE(second.empty());
+}
+
+TEST(RingBufferTest, IteratorsShouldSupportRandomAccessAcrossWrap)
+{
+    my_vec::ring_buffer<int> buffer(4);
+    buffer.push_back(2);
+    buffer.push_back(3);
+    buffer.push_front(1);
+    buffer.push_front(0);
+
+    auto it = buffer.begin();
+    it += 3;
+
+    EXPECT_EQ(*it, 3);
+    EXPECT_EQ(it[-2], 1);
+    EXPECT_EQ(buffer.end() - buffer.begin(), 4);
+    EXPECT_EQ(buffer[1], 1);
+    EXPECT_THROW(buffer.at(4), std::out_of_range);
+    std::sort(buffer.begin(), buffer.end(), std::greater<> {});
+    EXPECT_EQ(std::vector<int>(buffer.begin(), buffer.end()), (std::vector<int> { 3, 2, 1, 0 }));
+}
+
+TEST(RingBufferTest, CopyShouldDuplicateElementsAndMoveShouldStealBuffer)
+{
+    my_vec::ring_buffer<std::unique_ptr<int>> moveOnly(2);
+    moveOnly.push_back(std::make_unique<int>(1));
+    my_vec::ring_buffer<std::string> buffer(2, my_vec::overwrite_oldest);
+    buffer.push_back("a");
+    buffer.push_back("b");
+    buffer.push_back("c");
+
+    const auto copy = buffer;
+    const auto moved = std::move(moveOnly);
+
+    EXPECT_TRUE(copy.overwrites_oldest());
+    EXPECT_EQ(std::vector<std::string>(copy.begin(), copy.end()), (std::vector<std::string> { "b", "c" }));
+    EXPECT_EQ(*moved.front(), 1);
+    EXPECT_TRUE(moveOnly.empty());
+}
@@ -0,0 +1,155 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <sstream>
+#include <string>
+
+#include "serialization.hpp"
+
+constexpr std::size_t serializedVectorSize = 1000;
+
+struct Point {
+    std::int32_t x;
+    std::int32_t y;
+
+    friend bool operator==(const Point&, const Point&) = default;
+};
+
+TEST(Serialization, DeserializeShouldRestoreSerializedVectorOfArithmeticType)
+{
+    my_vec::vector<std::uint64_t> vec;
+    for (std::size_t i = 0; i < serializedVectorSize; ++i) {
+        vec.push_back(i * i);
+    }
+    std::stringstream stream;
+
+    my_vec::serialize(stream, vec);
+    my_vec::vector<std::uint64_t> result { 1, 2, 3 };
+    my_vec::deserialize(stream, result);
+
+    EXPECT_EQ(result, vec);
+}
+
+TEST(Serialization, DeserializeShouldRestoreSerializedVectorOfTriviallyCopyableStructs)
+{
+    my_vec::vector<Point> vec { { 1, 2 }, { 3, 4 }, { -5, 6 } };
+    std::stringstream stream;
+
+    my_vec::serialize(stream, vec);
+    my_vec::vector<Point> result;
+    my_vec::deserialize(stream, result);
+
+    EXPECT_EQ(result.size(), vec.size());
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(result[i], vec[i]);
+    }
+}
+
+TEST(Serialization, SerializedStreamShouldContainHeaderAndRawPayloadOnly)
+{
+    constexpr std::size_t headerSize = 24;
+    my_vec::vector<std::int32_t> vec(serializedVectorSize, 1);
+    std::stringstream stream;
+
+    my_vec::serialize(stream, vec);
+
+    EXPECT_EQ(stream.str().size(), headerSize + serializedVectorSize * sizeof(std::int32_t));
+}
+
+TEST(Serialization, DeserializeShouldRestoreSerializedBoolVector)
+{
+    my_vec::vector<bool> vec;
+    for (std::size_t i = 0; i < serializedVectorSize + 3; ++i) {
+        vec.push_back(i % 3 == 0);
+    }
+    std::stringstream stream;
+
+    my_vec::serialize(stream, vec);
+    my_vec::vector<bool> result;
+    my_vec::deserialize(stream, result);
+
+    ASSERT_EQ(result.size(), vec.size());
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(result[i], vec[i]);
+    }
+}
+
+TEST(Serialization, DeserializeShouldSwapBytesOfPayloadWrittenInOtherByteOrder)
+{
+    constexpr std::uint32_t value = 0x01020304;
+    my_vec::vector<std::uint32_t> vec(serializedVectorSize, value);
+    std::stringstream stream;
+    my_vec::serialize(stream, vec);
+
+    // Rewrite stream as if it was produced on machine with opposite byte order.
+    auto bytes = stream.str();
+    auto swap = [&bytes](std::size_t offset, std::size_t size) {
+        std::reverse(bytes.begin() + static_cast<std::ptrdiff_t>(offset), bytes.begin() + static_cast<std::ptrdiff_t>(offset + size));
+    };
+    bytes[6] = bytes[6] == 1 ? 2 : 1;
+    swap(4, 2);
+    swap(8, 4);
+    swap(16, 8);
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        swap(24 + i * sizeof(std::uint32_t), sizeof(std::uint32_t));
+    }
+    std::stringstream swappedStream { bytes };
+
+    my_vec::vector<std::uint32_t> result;
+    my_vec::deserialize(swappedStream, result);
+
+    EXPECT_EQ(result, vec);
+}
+
+TEST(Serialization, DeserializeShouldThrowWhenElementTypeDoesNotMatch)
+{
+    my_vec::vector<std::uint32_t> vec(serializedVectorSize, 1);
+    std::stringstream stream;
+    my_vec::serialize(stream, vec);
+
+    my_vec::vector<std::uint64_t> result;
+
+    EXPECT_THROW(my_vec::deserialize(stream, result), std::runtime_error);
+}
+
+TEST(Serialization, DeserializeShouldThrowWhenStreamIsTruncated)
+{
+    my_vec::vector<std::uint32_t> vec(serializedVectorSize, 1);
+    std::stringstream stream;
+    my_vec::serialize(stream, vec);
+    std::stringstream truncatedStream { stream.str().substr(0, stream.str().size() - 1) };
+
+    my_vec::vector<std::uint32_t> result;
+
+    EXPECT_THROW(my_vec::deserialize(truncatedStream, result), std::runtime_error);
+}
+
+TEST(Serialization, DeserializeShouldThrowWhenHeaderCountIsCorrupt)
+{
+    my_vec::vector<std::uint32_t> vec(serializedVectorSize, 1);
+    my_vec::vector<bool> bits(serializedVectorSize, true);
+    std::stringstream stream;
+    std::stringstream bitStream;
+    my_vec::serialize(stream, vec);
+    my_vec::serialize(bitStream, bits);
+
+    // Count is the last field of 24 byte header.
+    auto withCount = [](std::string bytes, std::uint64_t count) {
+        std::memcpy(bytes.data() + 16, &count, sizeof(count));
+        return std::stringstream { bytes };
+    };
+    my_vec::vector<std::uint32_t> result;
+    my_vec::vector<bool> bitResult;
+
+    for (const auto count : { std::numeric_limits<std::uint64_t>::max(), std::numeric_limits<std::uint64_t>::max() / 4 + 1, std::uint64_t { serializedVectorSize + 1 } }) {
+        auto corrupt = withCount(stream.str(), count);
+        EXPECT_THROW(my_vec::deserialize(corrupt, result), std::runtime_error);
+    }
+    for (const auto count : { std::numeric_limits<std::uint64_t>::max(), std::uint64_t { 64 * serializedVectorSize } }) {
+        auto corrupt = withCount(bitStream.str(), count);
+        EXPECT_THROW(my_vec::deserialize(corrupt, bitResult), std::runtime_error);
+    }
+}
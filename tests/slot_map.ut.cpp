@@ -0,0 +1,149 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "slot_map.hpp"
+#include "tracking_allocator.hpp"
+
+constexpr std::size_t slotMapOperations = 10'000;
+
+TEST(SlotMapTest, InsertShouldReturnKeysWhichStayValidAcrossEraseOfOtherElements)
+{
+    my_vec::slot_map<std::string> map;
+    const auto first = map.insert("first");
+    const auto second = map.emplace(3, 'x');
+    const auto third = map.insert("third");
+
+    EXPECT_TRUE(map.erase(first));
+
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_FALSE(map.contains(first));
+    EXPECT_EQ(map[second], "xxx");
+    EXPECT_EQ(map.at(third), "third");
+    EXPECT_THROW(static_cast<void>(map.at(first)), std::out_of_range);
+    EXPECT_EQ(map.find(first), map.end());
+    EXPECT_FALSE(map.erase(first));
+}
+
+TEST(SlotMapTest, ReusedSlotShouldNotBeReachableThroughStaleKey)
+{
+    my_vec::slot_map<int> map;
+    const auto stale = map.insert(1);
+    map.erase(stale);
+
+    const auto reused = map.insert(2);
+
+    EXPECT_EQ(reused.index, stale.index);
+    EXPECT_NE(reused.generation, stale.generation);
+    EXPECT_FALSE(map.contains(stale));
+    EXPECT_EQ(map[reused], 2);
+}
+
+TEST(SlotMapTest, ElementsShouldStayDenseAndKeyOfShouldMapPositionBackToKey)
+{
+    my_vec::slot_map<int> map;
+    std::vector<my_vec::slot_map<int>::key_type> keys;
+    for (int i = 0; i < 10; ++i) {
+        keys.push_back(map.insert(i));
+    }
+    map.erase(keys[0]);
+    map.erase(keys[5]);
+
+    EXPECT_EQ(map.end() - map.begin(), 8);
+    for (auto it = map.begin(); it != map.end(); ++it) {
+        EXPECT_EQ(map.key_of(it), keys[static_cast<std::size_t>(*it)]);
+    }
+
+    const auto next = map.erase(map.begin());
+    EXPECT_EQ(next, map.begin());
+    EXPECT_EQ(map.size(), 7);
+}
+
+TEST(SlotMapTest, ClearShouldInvalidateEveryKeyAndReuseSlots)
+{
+    my_vec::slot_map<std::unique_ptr<int>> map;
+    const auto first = map.insert(std::make_unique<int>(1));
+    const auto second = map.insert(std::make_unique<int>(2));
+
+    map.clear();
+    const auto third = map.insert(std::make_unique<int>(3));
+
+    EXPECT_FALSE(map.contains(first));
+    EXPECT_FALSE(map.contains(second));
+    EXPECT_LT(third.index, 2);
+    EXPECT_EQ(*map[third], 3);
+    EXPECT_FALSE(map.contains(my_vec::slot_map<std::unique_ptr<int>>::key_type {}));
+}
+
+TEST(SlotMapTest, ThrowingConstructionShouldLeaveMapUnchanged)
+{
+    struct throwing {
+        explicit throwing(bool shouldThrow)
+        {
+            if (shouldThrow) {
+                throw std::runtime_error { "construction failed" };
+            }
+        }
+    };
+    my_vec::slot_map<throwing> map;
+    const auto key = map.emplace(false);
+
+    EXPECT_THROW(map.emplace(true), std::runtime_error);
+
+    EXPECT_EQ(map.size(), 1);
+    EXPECT_TRUE(map.contains(key));
+    EXPECT_EQ(map.key_of(map.begin()), key);
+    map.emplace(false);
+    EXPECT_EQ(map.size(), 2);
+}
+
+TEST(SlotMapTest, EveryInternalVectorShouldAllocateThroughGivenAllocator)
+{
+    using tracking = my_alloc::tracking_allocator<my_alloc::allocator<std::size_t>>;
+    my_alloc::tracking_registry::instance().reset();
+    {
+        my_vec::slot_map<std::size_t, tracking> map { tracking {} };
+        map.insert(1);
+
+        // Elements, dense-to-slot table and slots are three separate blocks.
+        const auto snapshot = my_alloc::tracking_registry::instance().snapshot();
+        EXPECT_EQ(snapshot.allocations, 3);
+        EXPECT_EQ(snapshot.liveBytes, static_cast<std::int64_t>(sizeof(std::size_t) + 3 * sizeof(std::uint32_t)));
+    }
+
+    EXPECT_EQ(my_alloc::tracking_registry::instance().snapshot().liveBytes, 0);
+}
+
+TEST(SlotMapTest, RandomOperationsShouldMatchMap)
+{
+    std::mt19937 engine { 42 };
+    my_vec::slot_map<std::size_t> map;
+    std::map<std::size_t, my_vec::slot_map<std::size_t>::key_type> expected;
+    std::vector<my_vec::slot_map<std::size_t>::key_type> erased;
+
+    for (std::size_t i = 0; i < slotMapOperations; ++i) {
+        if (engine() % 3 != 0 || expected.empty()) {
+            expected.emplace(i, map.insert(i));
+        } else {
+            auto it = expected.begin();
+            std::advance(it, static_cast<std::ptrdiff_t>(engine() % expected.size()));
+            ASSERT_TRUE(map.erase(it->second));
+            erased.push_back(it->second);
+            expected.erase(it);
+        }
+    }
+
+    ASSERT_EQ(map.size(), expected.size());
+    for (const auto& [value, key] : expected) {
+        ASSERT_EQ(map.at(key), value);
+    }
+    EXPECT_TRUE(std::none_of(erased.begin(), erased.end(), [&map](auto key) { return map.contains(key); }));
+}
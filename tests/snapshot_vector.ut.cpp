@@ -0,0 +1,110 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "snapshot_vector.hpp"
+
+constexpr std::size_t snapshotReaders = 4;
+constexpr std::size_t snapshotUpdates = 500;
+
+TEST(SnapshotVectorTest, ReadShouldSeeInitialValues)
+{
+    const my_vec::snapshot_vector<int> vec(my_vec::vector<int> { 1, 2, 3 });
+
+    const auto snapshot = vec.read();
+
+    EXPECT_EQ(snapshot.size(), 3);
+    EXPECT_EQ(snapshot[1], 2);
+    EXPECT_EQ(snapshot.values(), (my_vec::vector<int> { 1, 2, 3 }));
+    EXPECT_THROW(static_cast<void>(snapshot.at(3)), std::out_of_range);
+}
+
+TEST(SnapshotVectorTest, SnapshotShouldKeepValuesItWasTakenWith)
+{
+    my_vec::snapshot_vector<std::string> vec(my_vec::vector<std::string> { "old" });
+    const auto before = vec.read();
+
+    vec.update([](auto& values) { values.push_back("new"); });
+    vec.publish(my_vec::vector<std::string> { "replaced" });
+    const auto after = vec.read();
+
+    EXPECT_EQ(before.values(), (my_vec::vector<std::string> { "old" }));
+    EXPECT_EQ(after.values(), (my_vec::vector<std::string> { "replaced" }));
+    EXPECT_EQ(vec.epoch(), 3);
+}
+
+TEST(SnapshotVectorTest, ReplacedBufferShouldBeReclaimedOnlyAfterReadersLeave)
+{
+    my_vec::snapshot_vector<int> vec(my_vec::vector<int> { 1 });
+    auto snapshot = vec.read();
+
+    vec.update([](auto& values) { values[0] = 2; });
+    vec.update([](auto& values) { values[0] = 3; });
+    EXPECT_EQ(vec.reclaim(), 2);
+
+    auto moved = std::move(snapshot);
+    EXPECT_EQ(moved[0], 1);
+    EXPECT_EQ(vec.reclaim(), 2);
+
+    moved = vec.read();
+    EXPECT_EQ(moved[0], 3);
+    EXPECT_EQ(vec.reclaim(), 0);
+}
+
+TEST(SnapshotVectorTest, ReaderShouldWaitForFreeSlotWhenAllSlotsAreTaken)
+{
+    my_vec::snapshot_vector<int> vec(my_vec::vector<int> { 7 }, 2);
+
+    const auto first = vec.read();
+    auto second = vec.read();
+    std::thread reader([&vec, &first] {
+        // Both slots are taken, reader has to wait until main thread releases one.
+        const auto third = vec.read();
+        EXPECT_EQ(third[0], first[0]);
+    });
+    {
+        const auto released = std::move(second);
+    }
+    reader.join();
+
+    EXPECT_EQ(first[0], 7);
+}
+
+TEST(SnapshotVectorTest, ConcurrentReadersShouldAlwaysSeeConsistentBuffer)
+{
+    my_vec::snapshot_vector<std::size_t> vec(my_vec::vector<std::size_t>(64, 0));
+    std::atomic<bool> done = false;
+    std::atomic<bool> consistent = true;
+
+    std::vector<std::thread> readers;
+    for (std::size_t r = 0; r < snapshotReaders; ++r) {
+        readers.emplace_back([&] {
+            std::size_t lastSeen = 0;
+            while (!done.load()) {
+                const auto snapshot = vec.read();
+                const auto value = snapshot[0];
+                if (std::any_of(snapshot.begin(), snapshot.end(), [value](auto element) { return element != value; }) || value < lastSeen) {
+                    consistent = false;
+                }
+                lastSeen = value;
+                std::this_thread::yield();
+            }
+        });
+    }
+    for (std::size_t i = 1; i <= snapshotUpdates; ++i) {
+        vec.update([i](auto& values) { std::fill(values.begin(), values.end(), i); });
+    }
+    done = true;
+    for (auto& reader : readers) {
+        reader.join();
+    }
+
+    EXPECT_TRUE(consistent);
+    EXPECT_EQ(vec.read()[0], snapshotUpdates);
+    EXPECT_EQ(vec.reclaim(), 0);
+}
@@ -0,0 +1,232 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "sparse_vector.hpp"
+#include "tracking_allocator.hpp"
+
+static_assert(std::forward_iterator<my_vec::sparse_vector<int>::iterator>);
+static_assert(std::forward_iterator<my_vec::sparse_vector<int>::const_iterator>);
+
+constexpr std::size_t sparseIndexSpace = 1'000'000'000;
+constexpr std::size_t sparseOperations = 10'000;
+constexpr std::size_t sparseEntries = 100'000;
+
+TEST(SparseVectorTest, TryEmplaceShouldPopulateOnlyAbsentIndices)
+{
+    my_vec::sparse_vector<std::string> vec;
+
+    const auto [it, inserted] = vec.try_emplace(sparseIndexSpace - 1, 3, 'x');
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it.index(), sparseIndexSpace - 1);
+    EXPECT_EQ(*it, "xxx");
+    EXPECT_FALSE(vec.try_emplace(sparseIndexSpace - 1, "other").second);
+
+    EXPECT_EQ(vec.size(), 1);
+    EXPECT_EQ(vec.allocated_pages(), 1);
+    EXPECT_EQ(vec.at(sparseIndexSpace - 1), "xxx");
+    EXPECT_THROW(static_cast<void>(vec.at(5)), std::out_of_range);
+    EXPECT_FALSE(vec.contains(5));
+    EXPECT_EQ(vec.find(5), vec.end());
+}
+
+TEST(SparseVectorTest, InsertOrAssignShouldOverwritePopulatedIndex)
+{
+    my_vec::sparse_vector<int> vec;
+
+    EXPECT_TRUE(vec.insert_or_assign(10, 1).second);
+    EXPECT_FALSE(vec.insert_or_assign(10, 2).second);
+
+    EXPECT_EQ(vec[10], 2);
+    EXPECT_EQ(vec.size(), 1);
+}
+
+TEST(SparseVectorTest, IterationShouldVisitOnlyPopulatedEntriesInIndexOrder)
+{
+    // Pages of 1024 slots keep 16 occupancy words each.
+    my_vec::sparse_vector<std::size_t, my_alloc::allocator<std::size_t>, 1024> vec;
+    const std::vector<std::size_t> indices { 0, 63, 64, 1023, 1024, 5000, 123'456'789, sparseIndexSpace - 1 };
+    for (auto it = indices.rbegin(); it != indices.rend(); ++it) {
+        vec.try_emplace(*it, *it * 2);
+    }
+
+    std::vector<std::size_t> visited;
+    for (auto it = std::as_const(vec).begin(); it != vec.end(); ++it) {
+        EXPECT_EQ(*it, it.index() * 2);
+        visited.push_back(it.index());
+    }
+
+    EXPECT_EQ(visited, indices);
+    EXPECT_EQ(vec.allocated_pages(), 5);
+}
+
+TEST(SparseVectorTest, ErasingLastEntryOfPageShouldReleasePage)
+{
+    my_vec::sparse_vector<std::unique_ptr<int>> vec;
+    vec.try_emplace(5000, std::make_unique<int>(1));
+    vec.try_emplace(5001, std::make_unique<int>(2));
+
+    EXPECT_EQ(vec.erase(5000), 1);
+    EXPECT_EQ(vec.allocated_pages(), 1);
+    EXPECT_EQ(vec.erase(5000), 0);
+    EXPECT_EQ(vec.erase(5001), 1);
+
+    EXPECT_EQ(vec.allocated_pages(), 0);
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.begin(), vec.end());
+}
+
+TEST(SparseVectorTest, CopyShouldDuplicateEntriesAndMoveShouldStealThem)
+{
+    my_vec::sparse_vector<std::string> vec;
+    vec.try_emplace(7, "seven");
+    vec.try_emplace(70'000, "seventy thousand");
+
+    my_vec::sparse_vector<std::string> copy;
+    copy.try_emplace(1, "overwritten");
+    copy = vec;
+    const auto moved = std::move(vec);
+
+    EXPECT_EQ(copy.size(), 2);
+    EXPECT_FALSE(copy.contains(1));
+    EXPECT_EQ(copy[70'000], "seventy thousand");
+    EXPECT_EQ(moved[7], "seven");
+    EXPECT_TRUE(vec.empty());
+    EXPECT_EQ(vec.allocated_pages(), 0);
+}
+
+TEST(SparseVectorTest, RandomOperationsShouldMatchMap)
+{
+    std::mt19937_64 engine { 42 };
+    my_vec::sparse_vector<std::size_t, my_alloc::allocator<std::size_t>, 64> vec;
+    std::map<std::size_t, std::size_t> expected;
+
+    for (std::size_t i = 0; i < sparseOperations; ++i) {
+        // Small index space makes erasures hit populated entries and empty pages.
+        const auto index = engine() % 20'000;
+        if (engine() % 3 == 0) {
+            EXPECT_EQ(vec.erase(index), expected.erase(index));
+        } else {
+            vec.insert_or_assign(index, i);
+            expected.insert_or_assign(index, i);
+        }
+    }
+
+    ASSERT_EQ(vec.size(), expected.size());
+    auto it = vec.begin();
+    for (const auto& [index, value] : expected) {
+        ASSERT_EQ(it.index(), index);
+        ASSERT_EQ(*it, value);
+        ++it;
+    }
+    EXPECT_EQ(it, vec.end());
+}
+
+TEST(SparseVectorTest, MemoryShouldGrowWithEntriesNotWithIndexSpace)
+{
+    using tracking = my_alloc::tracking_allocator<my_alloc::allocator<std::size_t>>;
+    my_alloc::tracking_registry::instance().reset();
+    std::mt19937_64 engine { 42 };
+    std::vector<std::size_t> indices;
+    {
+        my_vec::sparse_vector<std::size_t, tracking> vec { tracking {} };
+        while (vec.size() < sparseEntries) {
+            const auto index = engine() % sparseIndexSpace;
+            if (vec.try_emplace(index, index).second) {
+                indices.push_back(index);
+            }
+        }
+
+        // Flat directory of full 1024 slot pages needed over 800 MB here, 8 bytes of payload per entry is the floor.
+        const auto liveBytes = static_cast<std::size_t>(my_alloc::tracking_registry::instance().snapshot().liveBytes);
+        EXPECT_LT(liveBytes, sparseEntries * 100);
+        EXPECT_GE(liveBytes, sparseEntries * sizeof(std::size_t));
+
+        std::shuffle(indices.begin(), indices.end(), engine);
+        for (const auto index : indices) {
+            ASSERT_EQ(vec.at(index), index);
+            ASSERT_EQ(vec.erase(index), 1);
+        }
+        EXPECT_TRUE(vec.empty());
+        EXPECT_EQ(vec.allocated_pages(), 0);
+        EXPECT_EQ(my_alloc::tracking_registry::instance().snapshot().liveBytes, 0);
+    }
+    EXPECT_EQ(my_alloc::tracking_registry::instance().snapshot().liveBytes, 0);
+}
+
+TEST(SparseVectorTest, RandomOperationsOverHugeIndexSpaceShouldMatchMap)
+{
+    std::mt19937_64 engine { 7 };
+    my_vec::sparse_vector<std::string> vec;
+    std::map<std::size_t, std::string> expected;
+
+    for (std::size_t i = 0; i < sparseOperations; ++i) {
+        // Indices cluster below 4096 half of the time, so pages get several entries and branches several children.
+        const auto index = engine() % 2 == 0 ? engine() % 4096 : engine();
+        if (engine() % 4 == 0 && !expected.empty()) {
+            const auto victim = expected.lower_bound(index) == expected.end() ? expected.begin()->first : expected.lower_bound(index)->first;
+            EXPECT_EQ(vec.erase(victim), expected.erase(victim));
+        } else {
+            vec.insert_or_assign(index, std::to_string(i));
+            expected.insert_or_assign(index, std::to_string(i));
+        }
+    }
+
+    ASSERT_EQ(vec.size(), expected.size());
+    auto it = vec.begin();
+    for (const auto& [index, value] : expected) {
+        ASSERT_EQ(it.index(), index);
+        ASSERT_EQ(*it, value);
+        ++it;
+    }
+    EXPECT_EQ(it, vec.end());
+    EXPECT_EQ(vec.find(expected.rbegin()->first + 1), vec.end());
+}
+
+TEST(SparseSetTest, InsertAndEraseShouldKeepMembersDense)
+{
+    my_vec::sparse_set set;
+
+    EXPECT_TRUE(set.insert(sparseIndexSpace - 1));
+    EXPECT_TRUE(set.insert(3));
+    EXPECT_TRUE(set.insert(500'000));
+    EXPECT_FALSE(set.insert(3));
+
+    EXPECT_TRUE(set.erase(sparseIndexSpace - 1));
+    EXPECT_FALSE(set.erase(sparseIndexSpace - 1));
+
+    EXPECT_EQ(std::vector<std::size_t>(set.begin(), set.end()), (std::vector<std::size_t> { 500'000, 3 }));
+    EXPECT_EQ(set.position_of(3), 1);
+    EXPECT_TRUE(set.contains(500'000));
+    EXPECT_FALSE(set.contains(sparseIndexSpace - 1));
+}
+
+TEST(SparseSetTest, RandomOperationsShouldMatchStdSet)
+{
+    std::mt19937_64 engine { 7 };
+    my_vec::sparse_set set;
+    std::set<std::size_t> expected;
+
+    for (std::size_t i = 0; i < sparseOperations; ++i) {
+        const auto index = engine() % 5000;
+        if (engine() % 2 == 0) {
+            EXPECT_EQ(set.erase(index), expected.erase(index) == 1);
+        } else {
+            EXPECT_EQ(set.insert(index), expected.insert(index).second);
+        }
+    }
+
+    ASSERT_EQ(set.size(), expected.size());
+    for (std::size_t position = 0; position < set.size(); ++position) {
+        EXPECT_EQ(set.position_of(set.data()[position]), position);
+    }
+    EXPECT_EQ(std::set<std::size_t>(set.begin(), set.end()), expected);
+}
@@ -0,0 +1,166 @@
+#include "gtest/gtest.h"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <numeric>
+#include <span>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "spsc_queue.hpp"
+
+constexpr std::size_t spscQueueTransfers = 200'000;
+
+static_assert(alignof(my_vec::spsc_queue<int>) == my_vec::spsc_queue<int>::cacheLineSize);
+static_assert(sizeof(my_vec::spsc_queue<int>) == 3 * my_vec::spsc_queue<int>::cacheLineSize);
+
+TEST(SpscQueueTest, CapacityShouldBeRoundedUpToPowerOfTwo)
+{
+    const my_vec::spsc_queue<int> queue(5);
+
+    EXPECT_EQ(queue.capacity(), 8);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, PushShouldFailWhenFullAndPopWhenEmpty)
+{
+    my_vec::spsc_queue<int> queue(4);
+
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_push(i));
+    }
+    EXPECT_FALSE(queue.try_push(4));
+    EXPECT_EQ(queue.size(), 4);
+
+    int value = -1;
+    for (int i = 0; i < 4; ++i) {
+        EXPECT_TRUE(queue.try_pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.try_pop(value));
+    EXPECT_EQ(queue.front(), nullptr);
+}
+
+TEST(SpscQueueTest, FrontAndPopShouldWorkWithMoveOnlyElements)
+{
+    my_vec::spsc_queue<std::unique_ptr<int>> queue(2);
+
+    EXPECT_TRUE(queue.try_emplace(std::make_unique<int>(7)));
+    auto* element = queue.front();
+    ASSERT_NE(element, nullptr);
+    EXPECT_EQ(**element, 7);
+    queue.pop();
+
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTest, BatchOperationsShouldWrapAroundRingInOrder)
+{
+    my_vec::spsc_queue<std::string> queue(8);
+    std::vector<std::string> input(20);
+    for (std::size_t i = 0; i < input.size(); ++i) {
+        input[i] = std::to_string(i);
+    }
+
+    std::array<std::string, 3> output;
+    std::size_t pushed = 0;
+    std::size_t popped = 0;
+    while (popped < input.size()) {
+        pushed += queue.try_push(std::span<const std::string>(input).subspan(pushed, std::min<std::size_t>(5, input.size() - pushed)));
+        const auto count = queue.try_pop(std::span<std::string>(output));
+        for (std::size_t i = 0; i < count; ++i) {
+            EXPECT_EQ(output[i], input[popped + i]);
+        }
+        popped += count;
+    }
+
+    EXPECT_EQ(queue.try_pop(std::span<std::string>(output)), 0);
+}
+
+TEST(SpscQueueTest, BatchPushShouldStoreOnlyPrefixWhichFits)
+{
+    my_vec::spsc_queue<int> queue(4);
+    const std::vector<int> input { 1, 2, 3, 4, 5, 6 };
+
+    EXPECT_EQ(queue.try_push(std::span<const int>(input)), 4);
+    EXPECT_EQ(queue.try_push(std::span<const int>(input)), 0);
+    EXPECT_EQ(queue.size(), 4);
+}
+
+TEST(SpscQueueTest, BatchOperationsShouldSeeSlotsFreedOrFilledSinceLastRefresh)
+{
+    my_vec::spsc_queue<int> queue(8);
+    std::vector<int> input(8);
+    std::iota(input.begin(), input.end(), 0);
+    std::vector<int> output(8);
+
+    EXPECT_EQ(queue.try_push(std::span<const int>(input).first(7)), 7);
+    EXPECT_EQ(queue.try_pop(std::span<int>(output).first(7)), 7);
+    // Producer's cached head still says one slot is free, consumer's cached tail says none is used.
+    EXPECT_EQ(queue.try_push(std::span<const int>(input)), 8);
+    EXPECT_EQ(queue.try_pop(std::span<int>(output)), 8);
+
+    EXPECT_EQ(output, input);
+}
+
+TEST(SpscQueueTest, DestructorShouldDestroyRemainingElements)
+{
+    const auto counter = std::make_shared<int>(0);
+    {
+        my_vec::spsc_queue<std::shared_ptr<int>> queue(4);
+        for (int i = 0; i < 3; ++i) {
+            queue.try_push(counter);
+        }
+        queue.pop();
+        EXPECT_EQ(counter.use_count(), 3);
+    }
+
+    EXPECT_EQ(counter.use_count(), 1);
+}
+
+TEST(SpscQueueTest, ConcurrentProducerAndConsumerShouldTransferEveryElementInOrder)
+{
+    my_vec::spsc_queue<std::size_t> queue(64);
+
+    std::thread producer([&queue] {
+        std::array<std::size_t, 16> batch {};
+        std::size_t next = 0;
+        while (next < spscQueueTransfers) {
+            if (next % 3 == 0) {
+                if (queue.try_push(next)) {
+                    ++next;
+                } else {
+                    std::this_thread::yield();
+                }
+                continue;
+            }
+            const auto size = std::min(batch.size(), spscQueueTransfers - next);
+            std::iota(batch.begin(), batch.begin() + static_cast<std::ptrdiff_t>(size), next);
+            const auto pushed = queue.try_push(std::span<const std::size_t>(batch.data(), size));
+            if (pushed == 0) {
+                std::this_thread::yield();
+            }
+            next += pushed;
+        }
+    });
+
+    std::array<std::size_t, 16> batch {};
+    std::size_t expected = 0;
+    bool inOrder = true;
+    while (expected < spscQueueTransfers) {
+        const auto count = queue.try_pop(std::span<std::size_t>(batch));
+        if (count == 0) {
+            std::this_thread::yield();
+        }
+        for (std::size_t i = 0; i < count; ++i) {
+            inOrder = inOrder && batch[i] == expected + i;
+        }
+        expected += count;
+    }
+    producer.join();
+
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(queue.empty());
+}
@@ -0,0 +1,68 @@
+#include "gtest/gtest.h"
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+constexpr std::size_t numOfWorkers = 4;
+constexpr std::size_t rangeSize = 10000;
+
+TEST(ThreadPool, ParallelForShouldVisitEveryIndexOfRangeExactlyOnce)
+{
+    my_vec::thread_pool pool(numOfWorkers, 1);
+    std::vector<std::atomic<int>> visits(rangeSize);
+
+    pool.parallel_for(0, rangeSize, [&visits](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            visits[i]++;
+        }
+    });
+
+    for (const auto& visit : visits) {
+        EXPECT_EQ(visit, 1);
+    }
+}
+
+TEST(ThreadPool, ParallelForShouldRunRangeShorterThanThresholdOnCallingThread)
+{
+    my_vec::thread_pool pool(numOfWorkers, rangeSize + 1);
+    std::size_t numOfCalls = 0;
+
+    pool.parallel_for(0, rangeSize, [&numOfCalls](std::size_t begin, std::size_t end) {
+        EXPECT_EQ(begin, 0);
+        EXPECT_EQ(end, rangeSize);
+        ++numOfCalls;
+    });
+
+    EXPECT_EQ(numOfCalls, 1);
+}
+
+TEST(ThreadPool, ParallelForShouldRethrowExceptionThrownByChunk)
+{
+    my_vec::thread_pool pool(numOfWorkers, 1);
+
+    EXPECT_THROW(pool.parallel_for(0, rangeSize, [](std::size_t begin, std::size_t) {
+        if (begin == 0) {
+            throw std::runtime_error { "chunk failed" };
+        }
+    }),
+        std::runtime_error);
+}
+
+TEST(ThreadPool, NestedParallelForShouldNotDeadlock)
+{
+    my_vec::thread_pool pool(numOfWorkers, 1);
+    std::atomic<std::size_t> total { 0 };
+
+    pool.parallel_for(0, numOfWorkers * 4, [&](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            pool.parallel_for(0, rangeSize, [&total](std::size_t innerBegin, std::size_t innerEnd) {
+                total += innerEnd - innerBegin;
+            });
+        }
+    });
+
+    EXPECT_EQ(total, numOfWorkers * 4 * rangeSize);
+}
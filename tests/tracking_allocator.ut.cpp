@@ -0,0 +1,103 @@
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <cstdint>
+#include <sstream>
+#include <memory>
+#include <thread>
+#include <type_traits>
+
+#include "tracking_allocator.hpp"
+#include "vector.hpp"
+
+using TrackingAllocator = my_alloc::tracking_allocator<my_alloc::allocator<std::uint64_t>>;
+
+static_assert(std::is_same_v<std::allocator_traits<TrackingAllocator>::rebind_alloc<char>, my_alloc::tracking_allocator<my_alloc::allocator<char>>>);
+static_assert(std::is_constructible_v<my_alloc::tracking_allocator<my_alloc::allocator<char>>, const TrackingAllocator&>);
+
+constexpr std::size_t numOfTrackedElements = 100;
+
+class TrackingAllocatorTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        my_alloc::tracking_registry::instance().reset();
+    }
+};
+
+TEST_F(TrackingAllocatorTest, AllocateAndDeallocateShouldUpdateLiveBytesAndHighWaterMark)
+{
+    TrackingAllocator allocator;
+
+    std::uint64_t* first = allocator.allocate(numOfTrackedElements);
+    std::uint64_t* second = allocator.allocate(1);
+    allocator.deallocate(first, numOfTrackedElements);
+
+    auto stats = my_alloc::tracking_registry::instance().snapshot();
+    EXPECT_EQ(stats.allocations, 2);
+    EXPECT_EQ(stats.deallocations, 1);
+    EXPECT_EQ(stats.liveBytes, static_cast<std::int64_t>(sizeof(std::uint64_t)));
+    EXPECT_EQ(stats.highWaterBytes, static_cast<std::int64_t>((numOfTrackedElements + 1) * sizeof(std::uint64_t)));
+
+    allocator.deallocate(second, 1);
+    stats = my_alloc::tracking_registry::instance().snapshot();
+    EXPECT_EQ(stats.liveBytes, 0);
+}
+
+TEST_F(TrackingAllocatorTest, HistogramShouldCountAllocationsInLog2SizeBuckets)
+{
+    TrackingAllocator allocator;
+
+    // 8 bytes falls into [8, 16) bucket, 800 bytes into [512, 1024) bucket.
+    allocator.deallocate(allocator.allocate(1), 1);
+    allocator.deallocate(allocator.allocate(numOfTrackedElements), numOfTrackedElements);
+
+    const auto stats = my_alloc::tracking_registry::instance().snapshot();
+    EXPECT_EQ(stats.sizeHistogram[4], 1);
+    EXPECT_EQ(stats.sizeHistogram[10], 1);
+}
+
+TEST_F(TrackingAllocatorTest, CountersShouldIncludeAllocationsFromOtherThreads)
+{
+    std::thread worker([] {
+        TrackingAllocator allocator;
+        allocator.deallocate(allocator.allocate(numOfTrackedElements), numOfTrackedElements);
+    });
+    worker.join();
+
+    const auto stats = my_alloc::tracking_registry::instance().snapshot();
+    EXPECT_EQ(stats.allocations, 1);
+    EXPECT_EQ(stats.deallocations, 1);
+}
+
+TEST_F(TrackingAllocatorTest, VectorWithTrackingAllocatorShouldReportEveryGrowth)
+{
+    {
+        my_vec::vector<std::uint64_t, TrackingAllocator> vec;
+        for (std::uint64_t i = 0; i < 5; ++i) {
+            vec.push_back(i);
+        }
+    }
+
+    const auto stats = my_alloc::tracking_registry::instance().snapshot();
+    EXPECT_EQ(stats.allocations, 4);
+    EXPECT_EQ(stats.deallocations, 4);
+    EXPECT_EQ(stats.liveBytes, 0);
+    EXPECT_EQ(stats.highWaterBytes, static_cast<std::int64_t>((4 + 8) * sizeof(std::uint64_t)));
+}
+
+TEST_F(TrackingAllocatorTest, DumpShouldExportCountersAsTextAndJson)
+{
+    TrackingAllocator allocator;
+    allocator.deallocate(allocator.allocate(1), 1);
+
+    std::ostringstream text;
+    my_alloc::tracking_registry::instance().dump_text(text);
+    EXPECT_NE(text.str().find("allocations: 1\n"), std::string::npos);
+    EXPECT_NE(text.str().find(">= 8 B: 1"), std::string::npos);
+
+    std::ostringstream json;
+    my_alloc::tracking_registry::instance().dump_json(json);
+    EXPECT_EQ(json.str().front(), '{');
+    EXPECT_NE(json.str().find("\"allocations\":1,"), std::string::npos);
+    EXPECT_NE(json.str().find("\"size_histogram\":[{\"min_bytes\":8,\"count\":1}]"), std::string::npos);
+}
@@ -1,8 +1,16 @@
 #include "gtest/gtest.h"
+#include <array>
+#include <cmath>
 #include <cstddef>
 #include <cstdint>
+#include <iterator>
+#include <ranges>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
 #include <string>
 
+#include "tracking_allocator.hpp"
 #include "vector.hpp"
 
 constexpr std::size_t vectorSize = 3;
@@ -66,6 +74,132 @@ protected:
     }
 };
 
+/*
+* Element which throws from copy and move constructor once given number of
+* them succeeded, move constructor is not noexcept so vector has to copy it.
+*/
+
+struct ThrowingElement {
+    static inline int liveCount = 0;
+    static inline int constructionsUntilThrow = -1;
+
+    int value;
+
+    explicit ThrowingElement(int v = 0)
+        : value { v }
+    {
+        ++liveCount;
+    }
+    ThrowingElement(const ThrowingElement& other)
+        : value { other.value }
+    {
+        throwIfRequested();
+        ++liveCount;
+    }
+    ThrowingElement(ThrowingElement&& other)
+        : value { other.value }
+    {
+        throwIfRequested();
+        ++liveCount;
+    }
+    ThrowingElement& operator=(const ThrowingElement& other) = default;
+    ~ThrowingElement() { --liveCount; }
+
+    static void throwIfRequested()
+    {
+        if (constructionsUntilThrow == 0) {
+            throw std::runtime_error { "ThrowingElement construction failed" };
+        }
+        if (constructionsUntilThrow > 0) {
+            --constructionsUntilThrow;
+        }
+    }
+};
+
+/*
+* Element counting its copies and moves, move constructor is noexcept so
+* vector is free to move it when relocating.
+*/
+
+struct CountingElement {
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    int value;
+
+    explicit CountingElement(int v = 0)
+        : value { v }
+    {
+    }
+    CountingElement(const CountingElement& other)
+        : value { other.value }
+    {
+        ++copies;
+    }
+    CountingElement(CountingElement&& other) noexcept
+        : value { other.value }
+    {
+        ++moves;
+    }
+    CountingElement& operator=(const CountingElement& other)
+    {
+        value = other.value;
+        ++copies;
+        return *this;
+    }
+    CountingElement& operator=(CountingElement&& other) noexcept
+    {
+        value = other.value;
+        ++moves;
+        return *this;
+    }
+    ~CountingElement() = default;
+
+    static void resetCounters()
+    {
+        copies = 0;
+        moves = 0;
+    }
+};
+
+class VectorExceptionSafetyTest : public ::testing::Test {
+protected:
+    using ThrowingVector = my_vec::vector<ThrowingElement, my_alloc::tracking_allocator<my_alloc::allocator<ThrowingElement>>>;
+
+    std::int64_t liveBytesBeforeTest_ = 0;
+
+    void SetUp() override
+    {
+        ThrowingElement::liveCount = 0;
+        ThrowingElement::constructionsUntilThrow = -1;
+        liveBytesBeforeTest_ = my_alloc::tracking_registry::instance().snapshot().liveBytes;
+    }
+
+    void TearDown() override
+    {
+        EXPECT_EQ(ThrowingElement::liveCount, 0);
+        EXPECT_EQ(my_alloc::tracking_registry::instance().snapshot().liveBytes, liveBytesBeforeTest_);
+    }
+
+    ThrowingVector makeThrowingVector(std::size_t size)
+    {
+        ThrowingVector vec;
+        vec.reserve(size);
+        for (std::size_t i = 0; i < size; ++i) {
+            vec.emplace_back(static_cast<int>(i));
+        }
+        return vec;
+    }
+
+    void expectValuesInOrder(const ThrowingVector& vec, std::size_t size)
+    {
+        EXPECT_EQ(vec.size(), size);
+        for (std::size_t i = 0; i < size; ++i) {
+            EXPECT_EQ(vec[i].value, static_cast<int>(i));
+        }
+    }
+};
+
 TEST(VectorConstructor, DefaultConstructorShouldCreateEmptyVector)
 {
     my_vec::vector<int> vec;
@@ -189,6 +323,91 @@ TEST_F(VectorTest, ResizeOfContainerWithGivenValueShouldSetGivenValueForNewEleme
     }
 }
 
+TEST(VectorConstructor, IteratorConstructorShouldAcceptInputIterators)
+{
+    std::istringstream stream { "1 2 3 4 5" };
+    my_vec::vector<int> vec(std::istream_iterator<int> { stream }, std::istream_iterator<int> {});
+
+    EXPECT_EQ(vec.size(), 5);
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(vec[i], static_cast<int>(i) + 1);
+    }
+}
+
+TEST(VectorConstructor, CountAndValueConstructorShouldBeChosenForIntegralArguments)
+{
+    my_vec::vector<int> vec(3, 100);
+
+    EXPECT_EQ(vec.size(), 3);
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(vec[i], 100);
+    }
+}
+
+TEST(VectorConstructor, DefaultInitConstructorShouldConstructVectorWithGivenCountOfDefaultInitializedElements)
+{
+    my_vec::vector<std::string> vec(vectorSize, my_vec::default_init);
+
+    EXPECT_EQ(vec.size(), vectorSize);
+    EXPECT_EQ(vec.capacity(), vectorSize);
+    for (std::size_t i = 0; i < vectorSize; ++i) {
+        EXPECT_TRUE(vec[i].empty());
+    }
+}
+
+TEST_F(VectorTest, ResizeForOverwriteShouldKeepExistingElementsAndAddElementsToOverwrite)
+{
+    constexpr std::size_t newVectorSize = 6;
+    auto vec = makeVectorWithSameSizeAndCapacity<int>(vectorSize, newValue);
+
+    vec.resize_for_overwrite(newVectorSize);
+    for (std::size_t i = vectorSize; i < newVectorSize; ++i) {
+        vec[i] = valueToInsert;
+    }
+
+    EXPECT_EQ(vec.size(), newVectorSize);
+    EXPECT_EQ(vec.capacity(), newVectorSize);
+    for (std::size_t i = 0; i < vectorSize; ++i) {
+        EXPECT_EQ(vec[i], newValue);
+    }
+    for (std::size_t i = vectorSize; i < newVectorSize; ++i) {
+        EXPECT_EQ(vec[i], valueToInsert);
+    }
+}
+
+TEST_F(VectorTest, ResizeForOverwriteShouldShrinkContainerToGivenCount)
+{
+    auto vec = makeVectorWithSameSizeAndCapacity<std::string>(vectorSize, stringValue);
+
+    vec.resize_for_overwrite(1);
+
+    EXPECT_EQ(vec.size(), 1);
+    EXPECT_EQ(vec.capacity(), vectorSize);
+    EXPECT_EQ(vec[0], stringValue);
+}
+
+TEST_F(VectorTest, AppendUninitializedShouldReturnSpanOverAppendedElements)
+{
+    constexpr std::size_t appendedCount = 2;
+    auto vec = makeVectorWithSameSizeAndCapacity<int>(vectorSize, newValue);
+
+    auto appended = vec.append_uninitialized(appendedCount);
+    for (auto& el : appended) {
+        el = valueToInsert;
+    }
+
+    EXPECT_EQ(appended.size(), appendedCount);
+    EXPECT_EQ(appended.data(), vec.data() + vectorSize);
+    EXPECT_EQ(vec.size(), vectorSize + appendedCount);
+    EXPECT_EQ(vec.capacity(), 2 * vectorSize);
+    for (std::size_t i = 0; i < vectorSize; ++i) {
+        EXPECT_EQ(vec[i], newValue);
+    }
+    for (std::size_t i = vectorSize; i < vec.size(); ++i) {
+        EXPECT_EQ(vec[i], valueToInsert);
+    }
+}
+
 TEST_F(VectorTest, BeginShouldReturnIteratorToFirstElementOfContainer)
 {
     constexpr int firstValue = 10;
@@ -571,7 +790,7 @@ TEST_F(VectorTest, InsertShouldInsertGivenCountRangeOfValueBeforeMiddlePosition)
     const auto distanceToMiddle = static_cast<std::size_t>(std::distance(vec.begin(), middleIterator));
 
     const auto vectorSizeAfterInsertion = vec.size() + numOfValuesToInsert;
-    const auto vectorCapacityAfterInsertion = vec.size() + numOfValuesToInsert;
+    const auto vectorCapacityAfterInsertion = std::max(vec.size() + numOfValuesToInsert, 2 * vec.capacity());
     vec.insert(middleIterator, numOfValuesToInsert, valueToInsert);
 
     EXPECT_EQ(vec.size(), vectorSizeAfterInsertion);
@@ -623,7 +842,7 @@ TEST_F(VectorTest, InsertShouldInsertGivenVectorBeforeMiddlePosition)
     const auto distanceToMiddle = static_cast<std::size_t>(std::distance(vec.begin(), middleIterator));
 
     const auto vectorSizeAfterInsertion = vec.size() + vecToInsert.size();
-    const auto vectorCapacityAfterInsertion = vec.size() + vecToInsert.size();
+    const auto vectorCapacityAfterInsertion = std::max(vec.size() + vecToInsert.size(), 2 * vec.capacity());
     vec.insert(middleIterator, vecToInsert.begin(), vecToInsert.end());
 
     EXPECT_EQ(vec.size(), vectorSizeAfterInsertion);
@@ -677,7 +896,7 @@ TEST_F(VectorTest, InsertShouldInsertGivenInitializerListBeforeMiddlePosition)
     const auto numOfValuesToInsert = initializerLst.size();
 
     const auto vectorSizeAfterInsertion = vec.size() + numOfValuesToInsert;
-    const auto vectorCapacityAfterInsertion = vec.size() + numOfValuesToInsert;
+    const auto vectorCapacityAfterInsertion = std::max(vec.size() + numOfValuesToInsert, 2 * vec.capacity());
     vec.insert(middleIterator, initializerLst);
 
     EXPECT_EQ(vec.size(), vectorSizeAfterInsertion);
@@ -718,6 +937,123 @@ TEST_F(VectorTest, InsertShouldInsertGivenInitializerListToEmptyVector)
     }
 }
 
+TEST_F(VectorTest, AssignShouldReplaceContentWithCountCopiesOfValue)
+{
+    auto vec = makeVectorWithSizeAndCapacity<int>(vectorSize, vectorCapacity, newValue);
+    const std::size_t numOfValuesToAssign = 4;
+
+    vec.assign(numOfValuesToAssign, valueToInsert);
+
+    EXPECT_EQ(vec.size(), numOfValuesToAssign);
+    EXPECT_EQ(vec.capacity(), vectorCapacity);
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(vec[i], valueToInsert);
+    }
+}
+
+TEST_F(VectorTest, AssignShouldAllocateExactlyForCountLargerThanCapacity)
+{
+    auto vec = makeVectorWithSizeAndCapacity<std::string>(vectorSize, vectorCapacity, stringValue);
+    const std::size_t numOfValuesToAssign = 2 * vectorCapacity + 1;
+
+    vec.assign(numOfValuesToAssign, vec[0]);
+
+    EXPECT_EQ(vec.size(), numOfValuesToAssign);
+    EXPECT_EQ(vec.capacity(), numOfValuesToAssign);
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(vec[i], stringValue);
+    }
+}
+
+TEST_F(VectorTest, AssignShouldReplaceContentWithElementsOfIteratorRange)
+{
+    auto vec = makeVectorWithSizeAndCapacity<std::string>(vectorSize, vectorCapacity, stringValue);
+    const std::string values[] { "a", "b" };
+
+    vec.assign(std::begin(values), std::end(values));
+
+    EXPECT_EQ(vec.size(), 2);
+    EXPECT_EQ(vec.capacity(), vectorCapacity);
+    EXPECT_EQ(vec[0], "a");
+    EXPECT_EQ(vec[1], "b");
+}
+
+TEST_F(VectorTest, AssignRangeShouldAcceptInputOnlyRange)
+{
+    auto vec = makeVectorWithSizeAndCapacity<int>(vectorSize, vectorCapacity, newValue);
+    std::istringstream stream { "7 8 9 10 11 12 13" };
+
+    vec.assign_range(std::ranges::istream_view<int>(stream));
+
+    EXPECT_EQ(vec.size(), 7);
+    for (std::size_t i = 0; i < vec.size(); ++i) {
+        EXPECT_EQ(vec[i], static_cast<int>(i) + 7);
+    }
+}
+
+TEST_F(VectorTest, AppendRangeShouldGrowGeometricallyWithSingleReallocation)
+{
+    auto vec = makeVectorWithSameSizeAndCapacity<int>(vectorSize, newValue);
+    const auto valuesToAppend = makeVectorWithSameSizeAndCapacity<int>(2, valueToInsert);
+
+    vec.append_range(valuesToAppend);
+
+    EXPECT_EQ(vec.size(), vectorSize + 2);
+    EXPECT_EQ(vec.capacity(), 2 * vectorSize);
+    for (std::size_t i = 0; i < vectorSize; ++i) {
+        EXPECT_EQ(vec[i], newValue);
+    }
+    EXPECT_EQ(vec[vectorSize], valueToInsert);
+    EXPECT_EQ(vec[vectorSize + 1], valueToInsert);
+}
+
+TEST_F(VectorTest, AppendRangeShouldAllocateWholeRangeWhenItExceedsDoubledCapacity)
+{
+    auto vec = makeVectorWithSameSizeAndCapacity<int>(vectorSize, newValue);
+
+    vec.append_range(std::views::iota(0, 10));
+
+    EXPECT_EQ(vec.size(), vectorSize + 10);
+    EXPECT_EQ(vec.capacity(), vectorSize + 10);
+    for (std::size_t i = vectorSize; i < vec.size(); ++i) {
+        EXPECT_EQ(vec[i], static_cast<int>(i - vectorSize));
+    }
+}
+
+TEST_F(VectorTest, AppendRangeShouldAcceptInputOnlyRange)
+{
+    auto vec = makeEmptyVector<std::string>();
+    std::istringstream stream { "a b c" };
+
+    vec.append_range(std::ranges::istream_view<std::string>(stream));
+
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(vec[0], "a");
+    EXPECT_EQ(vec[1], "b");
+    EXPECT_EQ(vec[2], "c");
+}
+
+TEST_F(VectorTest, InsertRangeShouldInsertElementsOfRangeBeforeMiddlePosition)
+{
+    auto vec = makeVectorWithSizeAndCapacity<int>(vectorSize, vectorCapacity, newValue);
+    const auto distanceToMiddle = vectorSize / 2;
+    std::istringstream stream { "1 2 3 4" };
+
+    const auto it = vec.insert_range(vec.begin() + distanceToMiddle, std::ranges::istream_view<int>(stream));
+
+    EXPECT_EQ(it, vec.begin() + distanceToMiddle);
+    EXPECT_EQ(vec.size(), vectorSize + 4);
+    for (std::size_t i = 0; i < distanceToMiddle; ++i) {
+        EXPECT_EQ(vec[i], newValue);
+    }
+    for (std::size_t i = 0; i < 4; ++i) {
+        EXPECT_EQ(vec[distanceToMiddle + i], static_cast<int>(i) + 1);
+    }
+    for (std::size_t i = distanceToMiddle + 4; i < vec.size(); ++i) {
+        EXPECT_EQ(vec[i], newValue);
+    }
+}
+
 TEST_F(VectorTest, EmplaceBackShouldConstructElementAtTheEndOfContainerAndIncreaseSizeOfContainer)
 {
     auto vec = makeVectorWithSizeAndCapacity<std::string>(vectorSize, vectorCapacity);
@@ -799,6 +1135,87 @@ TEST_F(VectorTest, EraseShouldErasesLastElementsFromTheContainer)
     EXPECT_EQ(it, vec.end());
 }
 
+TEST_F(VectorTest, EraseShouldEraseGivenRangeFromTheContainer)
+{
+    auto vec = makeEmptyVector<std::string>();
+    vec.assign({ "a", "b", "c", "d", "e" });
+
+    auto it = vec.erase(vec.begin() + 1, vec.begin() + 3);
+
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(vec.capacity(), 5);
+    EXPECT_EQ(it, vec.begin() + 1);
+    EXPECT_EQ(vec[0], "a");
+    EXPECT_EQ(vec[1], "d");
+    EXPECT_EQ(vec[2], "e");
+}
+
+TEST_F(VectorTest, EraseOfEmptyRangeShouldNotChangeTheContainer)
+{
+    auto vec = makeVectorWithSameSizeAndCapacity<int>(vectorSize, newValue);
+
+    auto it = vec.erase(vec.begin() + 1, vec.begin() + 1);
+
+    EXPECT_EQ(vec.size(), vectorSize);
+    EXPECT_EQ(it, vec.begin() + 1);
+}
+
+TEST_F(VectorTest, EraseShouldKeepOrderOfRemainingElements)
+{
+    auto vec = makeEmptyVector<int>();
+    vec.assign({ 1, 2, 3, 4 });
+
+    vec.erase(vec.begin() + 1);
+
+    EXPECT_EQ(vec, (my_vec::vector<int> { 1, 3, 4 }));
+}
+
+TEST_F(VectorTest, UnstableEraseShouldReplaceErasedElementWithLastElement)
+{
+    auto vec = makeEmptyVector<std::string>();
+    vec.assign({ "a", "b", "c", "d" });
+
+    auto it = vec.unstable_erase(vec.begin() + 1);
+
+    EXPECT_EQ(vec.size(), 3);
+    EXPECT_EQ(it, vec.begin() + 1);
+    EXPECT_EQ(vec[0], "a");
+    EXPECT_EQ(vec[1], "d");
+    EXPECT_EQ(vec[2], "c");
+}
+
+TEST_F(VectorTest, UnstableEraseOfLastElementShouldReturnEnd)
+{
+    auto vec = makeVectorWithSameSizeAndCapacity<int>(vectorSize, newValue);
+
+    auto it = vec.unstable_erase(vec.end() - 1);
+
+    EXPECT_EQ(vec.size(), vectorSize - 1);
+    EXPECT_EQ(it, vec.end());
+}
+
+TEST_F(VectorTest, FreeEraseShouldRemoveAllElementsEqualToValue)
+{
+    auto vec = makeEmptyVector<int>();
+    vec.assign({ 1, valueToInsert, 2, valueToInsert, valueToInsert, 3 });
+
+    const auto numOfErased = my_vec::erase(vec, valueToInsert);
+
+    EXPECT_EQ(numOfErased, 3);
+    EXPECT_EQ(vec, (my_vec::vector<int> { 1, 2, 3 }));
+}
+
+TEST_F(VectorTest, FreeEraseIfShouldRemoveAllElementsSatisfyingPredicate)
+{
+    auto vec = makeEmptyVector<int>();
+    vec.assign({ 1, 2, 3, 4, 5, 6 });
+
+    const auto numOfErased = my_vec::erase_if(vec, [](int value) { return value % 2 == 0; });
+
+    EXPECT_EQ(numOfErased, 3);
+    EXPECT_EQ(vec, (my_vec::vector<int> { 1, 3, 5 }));
+}
+
 TEST_F(VectorTest, EmplaceShouldInsertGivenValueBeforeBeginAndEndPosition)
 {
     auto vec = makeVectorWithSizeAndCapacity<std::string>(vectorSize, vectorCapacity);
@@ -914,6 +1331,344 @@ TEST_F(VectorTest, SpaceshipOperatorShouldCompareNotEqualVectors)
     EXPECT_FALSE(first >= second);
 }
 
+TEST_F(VectorTest, SpaceshipOperatorShouldCompareByteVectorsAsUnsignedBytes)
+{
+    my_vec::vector<unsigned char> first { 1, 200 };
+    my_vec::vector<unsigned char> second { 1, 3 };
+    my_vec::vector<unsigned char> prefix { 1 };
+
+    EXPECT_TRUE(first > second);
+    EXPECT_TRUE(prefix < second);
+    EXPECT_TRUE((first <=> my_vec::vector<unsigned char> { 1, 200 }) == 0);
+    EXPECT_FALSE(first == second);
+}
+
+TEST_F(VectorTest, SpaceshipOperatorShouldKeepSignedOrderOfCharVectors)
+{
+    my_vec::vector<char> negative { 'a', static_cast<char>(-1) };
+    my_vec::vector<char> positive { 'a', 1 };
+
+    EXPECT_EQ(negative < positive, static_cast<char>(-1) < 1);
+    EXPECT_FALSE(negative == positive);
+}
+
+TEST_F(VectorTest, EqualityOperatorShouldCompareFloatingPointValuesInsteadOfBytes)
+{
+    my_vec::vector<double> positiveZero { 1.5, 0.0 };
+    my_vec::vector<double> negativeZero { 1.5, -0.0 };
+
+    EXPECT_TRUE(positiveZero == negativeZero);
+}
+
+TEST_F(VectorTest, ResizeShouldFillRepeatedAndMixedByteValues)
+{
+    constexpr int mixedBytesValue = 0x01020304;
+    auto vec = makeEmptyVector<int>();
+
+    vec.resize(vectorSize, -1);
+    vec.resize(2 * vectorSize, mixedBytesValue);
+    vec.resize(3 * vectorSize);
+
+    for (std::size_t i = 0; i < vectorSize; ++i) {
+        EXPECT_EQ(vec[i], -1);
+        EXPECT_EQ(vec[vectorSize + i], mixedBytesValue);
+        EXPECT_EQ(vec[2 * vectorSize + i], defaultValue);
+    }
+
+    const auto copy = vec;
+    EXPECT_EQ(copy, vec);
+}
+
+TEST_F(VectorExceptionSafetyTest, PushBackShouldLeaveVectorUnchangedWhenRelocationThrows)
+{
+    auto vec = makeThrowingVector(vectorSize);
+    const ThrowingElement element { valueToInsert };
+    ThrowingElement::constructionsUntilThrow = 2;
+
+    EXPECT_THROW(vec.push_back(element), std::runtime_error);
+
+    EXPECT_EQ(vec.capacity(), vectorSize);
+    expectValuesInOrder(vec, vectorSize);
+}
+
+TEST_F(VectorExceptionSafetyTest, PushBackShouldLeaveVectorUnchangedWhenNewElementThrows)
+{
+    auto vec = makeThrowingVector(vectorSize);
+    const ThrowingElement element { valueToInsert };
+    ThrowingElement::constructionsUntilThrow = 0;
+
+    EXPECT_THROW(vec.push_back(element), std::runtime_error);
+
+    EXPECT_EQ(vec.capacity(), vectorSize);
+    expectValuesInOrder(vec, vectorSize);
+}
+
+TEST_F(VectorExceptionSafetyTest, CopyConstructorShouldReleaseMemoryWhenElementCopyThrows)
+{
+    auto vec = makeThrowingVector(vectorSize);
+    ThrowingElement::constructionsUntilThrow = 1;
+
+    EXPECT_THROW(ThrowingVector { vec }, std::runtime_error);
+
+    expectValuesInOrder(vec, vectorSize);
+}
+
+TEST_F(VectorExceptionSafetyTest, CopyAssignmentShouldLeaveTargetUnchangedWhenElementCopyThrows)
+{
+    auto vec = makeThrowingVector(vectorSize);
+    auto source = makeThrowingVector(vectorCapacity);
+    ThrowingElement::constructionsUntilThrow = 2;
+
+    EXPECT_THROW(vec = source, std::runtime_error);
+
+    EXPECT_EQ(vec.capacity(), vectorSize);
+    expectValuesInOrder(vec, vectorSize);
+}
+
+TEST_F(VectorExceptionSafetyTest, AppendRangeShouldRollBackAppendedElementsWhenElementCopyThrows)
+{
+    auto vec = makeThrowingVector(vectorSize);
+    vec.reserve(vectorCapacity);
+    const auto source = makeThrowingVector(vectorSize);
+    ThrowingElement::constructionsUntilThrow = 1;
+
+    EXPECT_THROW(vec.append_range(source), std::runtime_error);
+
+    expectValuesInOrder(vec, vectorSize);
+}
+
+TEST_F(VectorExceptionSafetyTest, MoveAssignmentShouldReleasePreviousStorageOfTarget)
+{
+    auto vec = makeThrowingVector(vectorSize);
+    auto source = makeThrowingVector(vectorCapacity);
+
+    vec = std::move(source);
+
+    expectValuesInOrder(vec, vectorCapacity);
+    EXPECT_EQ(ThrowingElement::liveCount, static_cast<int>(vectorCapacity));
+}
+
+TEST_F(VectorExceptionSafetyTest, ResizeAndPopBackShouldDestroyRemovedElements)
+{
+    auto vec = makeThrowingVector(vectorCapacity);
+
+    vec.resize(vectorSize);
+    EXPECT_EQ(ThrowingElement::liveCount, static_cast<int>(vectorSize));
+
+    vec.pop_back();
+    EXPECT_EQ(ThrowingElement::liveCount, static_cast<int>(vectorSize) - 1);
+}
+
+TEST_F(VectorExceptionSafetyTest, InsertShouldConstructElementsInsteadOfAssigningOverRawMemory)
+{
+    auto vec = makeThrowingVector(vectorSize);
+    vec.reserve(vectorCapacity);
+
+    vec.insert(vec.begin() + 1, ThrowingElement { valueToInsert });
+
+    EXPECT_EQ(vec.size(), vectorSize + 1);
+    EXPECT_EQ(ThrowingElement::liveCount, static_cast<int>(vectorSize) + 1);
+    EXPECT_EQ(vec[0].value, 0);
+    EXPECT_EQ(vec[1].value, valueToInsert);
+    EXPECT_EQ(vec[2].value, 1);
+    EXPECT_EQ(vec[3].value, 2);
+}
+
+TEST_F(VectorTest, PushBackOfOwnElementShouldCopyItBeforeReallocation)
+{
+    auto vec = makeVectorWithSameSizeAndCapacity<std::string>(vectorSize, stringValue);
+
+    vec.push_back(vec[0]);
+
+    EXPECT_EQ(vec.size(), vectorSize + 1);
+    EXPECT_EQ(vec.back(), stringValue);
+}
+
+TEST_F(VectorTest, ResizeWithOwnElementShouldCopyItBeforeReallocation)
+{
+    auto vec = makeVectorWithSameSizeAndCapacity<std::string>(vectorSize, stringValue);
+
+    vec.resize(4 * vectorSize, vec[0]);
+
+    EXPECT_EQ(vec.size(), 4 * vectorSize);
+    EXPECT_EQ(vec.back(), stringValue);
+}
+
+TEST_F(VectorTest, ReserveShouldMoveElementsWhichCannotBeCopied)
+{
+    auto vec = makeEmptyVector<std::unique_ptr<int>>();
+    vec.push_back(std::make_unique<int>(newValue));
+
+    vec.reserve(vectorCapacity);
+    vec.emplace_back(std::make_unique<int>(valueToInsert));
+
+    EXPECT_EQ(*vec[0], newValue);
+    EXPECT_EQ(*vec[1], valueToInsert);
+}
+
+TEST_F(VectorTest, EmplaceWithReallocationShouldMoveEveryElementOnceAndConstructNewElementInPlace)
+{
+    auto vec = makeEmptyVector<CountingElement>();
+    vec.reserve(vectorSize);
+    for (std::size_t i = 0; i < vectorSize; ++i) {
+        vec.emplace_back(static_cast<int>(i));
+    }
+    CountingElement::resetCounters();
+
+    vec.emplace(vec.begin() + 1, valueToInsert);
+
+    EXPECT_EQ(CountingElement::copies, 0);
+    EXPECT_EQ(CountingElement::moves, static_cast<int>(vectorSize));
+    EXPECT_EQ(vec.capacity(), 2 * vectorSize);
+    EXPECT_EQ(vec[0].value, 0);
+    EXPECT_EQ(vec[1].value, valueToInsert);
+    EXPECT_EQ(vec[2].value, 1);
+    EXPECT_EQ(vec[3].value, 2);
+}
+
+TEST_F(VectorTest, InsertWithReallocationShouldCopyOnlyInsertedValue)
+{
+    auto vec = makeEmptyVector<CountingElement>();
+    vec.reserve(vectorSize);
+    for (std::size_t i = 0; i < vectorSize; ++i) {
+        vec.emplace_back(static_cast<int>(i));
+    }
+    const CountingElement element { valueToInsert };
+    CountingElement::resetCounters();
+
+    vec.insert(vec.begin(), element);
+
+    EXPECT_EQ(CountingElement::copies, 1);
+    EXPECT_EQ(CountingElement::moves, static_cast<int>(vectorSize));
+    EXPECT_EQ(vec[0].value, valueToInsert);
+}
+
+TEST_F(VectorTest, InsertOfRvalueWithoutReallocationShouldNotCreateTemporary)
+{
+    auto vec = makeEmptyVector<CountingElement>();
+    vec.reserve(vectorCapacity);
+    for (std::size_t i = 0; i < vectorSize; ++i) {
+        vec.emplace_back(static_cast<int>(i));
+    }
+    CountingElement::resetCounters();
+
+    vec.insert(vec.begin(), CountingElement { valueToInsert });
+
+    // Every old element is shifted once and inserted value is moved once into the gap.
+    EXPECT_EQ(CountingElement::copies, 0);
+    EXPECT_EQ(CountingElement::moves, static_cast<int>(vectorSize) + 1);
+    EXPECT_EQ(vec[0].value, valueToInsert);
+    EXPECT_EQ(vec[3].value, 2);
+}
+
+TEST_F(VectorTest, EmplaceOfOwnElementShouldInsertItsValueBeforeShifting)
+{
+    auto vec = makeEmptyVector<std::string>();
+    vec.assign({ "a", "b", "c" });
+    vec.reserve(vectorCapacity);
+
+    vec.emplace(vec.begin(), vec[2]);
+    vec.insert(vec.begin() + 1, vec.back());
+
+    EXPECT_EQ(vec, (my_vec::vector<std::string> { "c", "c", "a", "b", "c" }));
+}
+
+TEST_F(VectorExceptionSafetyTest, EmplaceWithReallocationShouldLeaveVectorUnchangedWhenRelocationThrows)
+{
+    auto vec = makeThrowingVector(vectorSize);
+    ThrowingElement::constructionsUntilThrow = 2;
+
+    EXPECT_THROW(vec.emplace(vec.begin() + 1, valueToInsert), std::runtime_error);
+
+    EXPECT_EQ(vec.capacity(), vectorSize);
+    expectValuesInOrder(vec, vectorSize);
+}
+
+/*
+* Vector used in constant expressions, every check below is evaluated by the compiler
+* through static_assert and repeated at runtime by the test which calls it.
+*/
+
+constexpr bool constexprVectorShouldGrowAndModifyElements()
+{
+    my_vec::vector<int> vec;
+    for (int i = 0; i < 10; ++i) {
+        vec.push_back(i);
+    }
+    vec.insert(vec.begin(), -1);
+    vec.emplace(vec.begin() + 5, 100);
+    vec.erase(vec.begin() + 1, vec.begin() + 3);
+    vec.pop_back();
+    vec.resize(12, 7);
+    vec.shrink_to_fit();
+    return vec.size() == 12 && vec.capacity() == 12 && vec.front() == -1 && vec[1] == 2 && vec[3] == 100 && vec.back() == 7;
+}
+
+constexpr bool constexprVectorShouldCopyMoveAndCompare()
+{
+    my_vec::vector<int> vec { 1, 2, 3 };
+    my_vec::vector<int> copy(vec);
+    my_vec::vector<int> moved(std::move(copy));
+    my_vec::vector<int> assigned;
+    assigned = moved;
+    assigned.append_range(my_vec::vector<int> { 4, 5 });
+    my_vec::erase_if(assigned, [](int value) { return value % 2 == 0; });
+    return moved == vec && copy.empty() && assigned == my_vec::vector<int> { 1, 3, 5 } && vec < assigned;
+}
+
+constexpr bool constexprVectorShouldManageLifetimeOfNonTrivialElements()
+{
+    my_vec::vector<std::string> vec(2, "constexpr");
+    vec.emplace_back(3, 'x');
+    vec.insert(vec.begin() + 1, std::string { "middle" });
+    vec.assign(4, "assigned");
+    vec.resize_for_overwrite(5);
+    return vec.size() == 5 && vec[0] == "assigned" && vec[3] == "assigned" && vec[4].empty();
+}
+
+constexpr bool constexprBoolVectorShouldStoreBits()
+{
+    my_vec::vector<bool> vec(3, true);
+    for (int i = 0; i < 100; ++i) {
+        vec.push_back(i % 3 == 0);
+    }
+    vec.pop_back();
+    vec.flip();
+    my_vec::vector<bool> copy(vec);
+    my_vec::vector<bool> moved;
+    moved = std::move(copy);
+    moved.resize(150, true);
+    moved = { true, false, true };
+    return vec.size() == 102 && !vec[0] && !vec[3] && vec[4] && moved.size() == 3 && moved[0] && !moved[1];
+}
+
+constexpr std::array<int, 8> makeSquaresTable()
+{
+    my_vec::vector<int> squares;
+    for (int i = 0; i < 8; ++i) {
+        squares.push_back(i * i);
+    }
+    std::array<int, 8> table {};
+    std::copy(squares.begin(), squares.end(), table.begin());
+    return table;
+}
+
+static_assert(constexprVectorShouldGrowAndModifyElements());
+static_assert(constexprVectorShouldCopyMoveAndCompare());
+static_assert(constexprVectorShouldManageLifetimeOfNonTrivialElements());
+static_assert(constexprBoolVectorShouldStoreBits());
+constexpr auto squaresTable = makeSquaresTable();
+static_assert(squaresTable[7] == 49);
+
+TEST(VectorConstexpr, ConstantEvaluatedChecksShouldHoldAtRuntime)
+{
+    EXPECT_TRUE(constexprVectorShouldGrowAndModifyElements());
+    EXPECT_TRUE(constexprVectorShouldCopyMoveAndCompare());
+    EXPECT_TRUE(constexprVectorShouldManageLifetimeOfNonTrivialElements());
+    EXPECT_TRUE(constexprBoolVectorShouldStoreBits());
+    EXPECT_EQ(makeSquaresTable(), squaresTable);
+}
+
 TEST_F(VectorBoolTest, DefaultConstructorShouldCreateEmptyBoolVector)
 {
     my_vec::vector<bool> vec;
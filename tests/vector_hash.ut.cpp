@@ -0,0 +1,135 @@
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "vector_hash.hpp"
+
+constexpr std::size_t hashedVectorSize = 1000;
+
+template <typename Vector>
+std::size_t hashOf(const Vector& vec)
+{
+    return std::hash<Vector> {}(vec);
+}
+
+TEST(VectorHash, EqualVectorsShouldHaveEqualHashes)
+{
+    my_vec::vector<std::uint32_t> first;
+    my_vec::vector<std::uint32_t> second;
+    for (std::uint32_t i = 0; i < hashedVectorSize; ++i) {
+        first.push_back(i * 7);
+        second.push_back(i * 7);
+    }
+
+    EXPECT_EQ(hashOf(first), hashOf(second));
+}
+
+TEST(VectorHash, HashShouldDependOnEveryElementForAllLengths)
+{
+    // Lengths cover every branch of byte kernel: short reads, 16 byte blocks and 48 byte blocks.
+    for (std::size_t size = 1; size <= 64; ++size) {
+        my_vec::vector<std::uint8_t> vec(size, 0);
+        const auto original = hashOf(vec);
+        for (std::size_t i = 0; i < size; ++i) {
+            vec[i] = 1;
+            EXPECT_NE(hashOf(vec), original) << "size " << size << ", index " << i;
+            vec[i] = 0;
+        }
+    }
+}
+
+TEST(VectorHash, HashShouldDependOnSize)
+{
+    my_vec::vector<std::uint32_t> vec;
+    std::unordered_set<std::size_t> hashes;
+    for (std::size_t i = 0; i < 100; ++i) {
+        hashes.insert(hashOf(vec));
+        vec.push_back(0);
+    }
+
+    EXPECT_EQ(hashes.size(), 100);
+}
+
+TEST(VectorHash, VectorShouldBeUsableAsUnorderedMapKey)
+{
+    std::unordered_map<my_vec::vector<std::uint32_t>, int> map;
+    map[{ 1, 2, 3 }] = 1;
+    map[{ 3, 2, 1 }] = 2;
+    map[{ 1, 2, 3 }] += 10;
+
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ((map[{ 1, 2, 3 }]), 11);
+    EXPECT_EQ((map[{ 3, 2, 1 }]), 2);
+}
+
+TEST(VectorHash, VectorOfStringsShouldCombineElementHashes)
+{
+    const my_vec::vector<std::string> first { "ab", "c" };
+    const my_vec::vector<std::string> second { "ab", "c" };
+    const my_vec::vector<std::string> third { "a", "bc" };
+
+    EXPECT_EQ(hashOf(first), hashOf(second));
+    EXPECT_NE(hashOf(first), hashOf(third));
+}
+
+TEST(VectorHash, VectorOfDoublesShouldHashNegativeAndPositiveZeroEqually)
+{
+    const my_vec::vector<double> positive { 1.0, 0.0 };
+    const my_vec::vector<double> negative { 1.0, -0.0 };
+
+    ASSERT_EQ(positive, negative);
+    EXPECT_EQ(hashOf(positive), hashOf(negative));
+}
+
+TEST(VectorHash, EqualBoolVectorsShouldHaveEqualHashes)
+{
+    my_vec::vector<bool> first;
+    my_vec::vector<bool> second;
+    for (std::size_t i = 0; i < hashedVectorSize; ++i) {
+        first.push_back(i % 3 == 0);
+        second.push_back(i % 3 == 0);
+    }
+
+    EXPECT_EQ(hashOf(first), hashOf(second));
+    second[hashedVectorSize - 1] = !second[hashedVectorSize - 1];
+    EXPECT_NE(hashOf(first), hashOf(second));
+}
+
+TEST(VectorHash, BoolVectorHashShouldIgnoreBitsPastSize)
+{
+    my_vec::vector<bool> shrunk(100, true);
+    shrunk.resize(70);
+    const my_vec::vector<bool> fresh(70, true);
+
+    EXPECT_EQ(hashOf(shrunk), hashOf(fresh));
+}
+
+TEST(VectorHash, BoolVectorHashShouldDependOnSize)
+{
+    const my_vec::vector<bool> shorter(64, false);
+    const my_vec::vector<bool> longer(65, false);
+
+    EXPECT_NE(hashOf(shorter), hashOf(longer));
+}
+
+TEST(VectorHash, BoolVectorShouldBeUsableAsUnorderedSetAndMapKey)
+{
+    my_vec::vector<bool> shrunk(100, true);
+    shrunk.resize(70);
+    std::unordered_set<my_vec::vector<bool>> set { my_vec::vector<bool>(70, true), my_vec::vector<bool>(64, false) };
+    std::unordered_map<my_vec::vector<bool>, int> map;
+    map[my_vec::vector<bool>(65, false)] = 1;
+    map[my_vec::vector<bool>(64, false)] = 2;
+
+    EXPECT_TRUE(shrunk == my_vec::vector<bool>(70, true));
+    EXPECT_FALSE(shrunk == my_vec::vector<bool>(71, true));
+    EXPECT_EQ(set.count(shrunk), 1);
+    EXPECT_EQ(set.count(my_vec::vector<bool>(64, true)), 0);
+    EXPECT_FALSE(set.insert(shrunk).second);
+    EXPECT_EQ(map.size(), 2);
+    EXPECT_EQ(map.at(my_vec::vector<bool>(65, false)), 1);
+    EXPECT_EQ(map.at(my_vec::vector<bool>(64, false)), 2);
+}
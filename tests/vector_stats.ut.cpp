@@ -0,0 +1,120 @@
+#include "gtest/gtest.h"
+#include <cstddef>
+#include <sstream>
+#include <string>
+#include <utility>
+
+#include "vector_stats.hpp"
+
+using TrackedVector = my_vec::vector<int, my_alloc::allocator<int>, my_vec::vector_stats>;
+
+constexpr std::size_t numOfPushedElements = 5;
+const std::string testSite = "VectorStatsTest";
+
+class VectorStatsTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        my_vec::stats_registry::instance().reset();
+    }
+};
+
+TEST_F(VectorStatsTest, DefaultStatsPolicyShouldNotIncreaseSizeOfVector)
+{
+    struct VectorWithoutStats {
+        my_alloc::allocator<int> alloc;
+        int* elem;
+        std::size_t size;
+        std::size_t space;
+    };
+    static_assert(sizeof(my_vec::vector<int>) == sizeof(VectorWithoutStats));
+}
+
+TEST_F(VectorStatsTest, StatsShouldCountAllocationsReallocationsAndMovedBytes)
+{
+    TrackedVector vec;
+
+    for (int i = 0; i < static_cast<int>(numOfPushedElements); ++i) {
+        vec.push_back(i);
+    }
+
+    // Capacity grows 1 -> 2 -> 4 -> 8, previous elements are copied on every growth.
+    const auto& counters = vec.stats().counters();
+    EXPECT_EQ(counters.allocations, 4);
+    EXPECT_EQ(counters.reallocations, 3);
+    EXPECT_EQ(counters.bytesMoved, (1 + 2 + 4) * sizeof(int));
+    EXPECT_EQ(counters.peakCapacityBytes, 8 * sizeof(int));
+}
+
+TEST_F(VectorStatsTest, DestroyedVectorShouldReportCountersToRegistryUnderItsTag)
+{
+    {
+        TrackedVector vec;
+        vec.stats().tag(testSite);
+        for (int i = 0; i < static_cast<int>(numOfPushedElements); ++i) {
+            vec.push_back(i);
+        }
+    }
+    {
+        TrackedVector vec(numOfPushedElements, 0);
+        vec.stats().tag(testSite);
+    }
+
+    const auto sites = my_vec::stats_registry::instance().snapshot();
+    ASSERT_EQ(sites.count(testSite), 1);
+    const auto& counters = sites.at(testSite);
+    EXPECT_EQ(counters.instances, 2);
+    EXPECT_EQ(counters.allocations, 5);
+    EXPECT_EQ(counters.reallocations, 3);
+    EXPECT_EQ(counters.wastedBytesAtDestruction, (8 - numOfPushedElements) * sizeof(int));
+}
+
+TEST_F(VectorStatsTest, TagWithoutArgumentsShouldUseCallSite)
+{
+    std::string site;
+    {
+        TrackedVector vec;
+        vec.stats().tag();
+        vec.push_back(1);
+        site = vec.stats().site();
+    }
+
+    EXPECT_NE(site.find("vector_stats.ut.cpp"), std::string::npos);
+
+    std::ostringstream out;
+    my_vec::stats_registry::instance().dump(out);
+    EXPECT_NE(out.str().find(site + ": instances=1"), std::string::npos);
+}
+
+TEST_F(VectorStatsTest, UntaggedAndNeverAllocatingInstancesShouldNotBeRecorded)
+{
+    {
+        TrackedVector untagged(numOfPushedElements, 0);
+        TrackedVector source(numOfPushedElements, 0);
+        source.stats().tag(testSite);
+        // Moved-from shell is left untagged and without allocations.
+        const TrackedVector target(std::move(source));
+    }
+
+    const auto sites = my_vec::stats_registry::instance().snapshot();
+    EXPECT_EQ(sites.count(my_vec::vector_stats::untaggedSite), 0);
+    ASSERT_EQ(sites.count(testSite), 1);
+    EXPECT_EQ(sites.at(testSite).instances, 1);
+}
+
+TEST_F(VectorStatsTest, MoveAndSwapShouldTransferStatsTogetherWithStorage)
+{
+    TrackedVector first(numOfPushedElements, 0);
+    first.stats().tag(testSite);
+    TrackedVector second;
+
+    second.swap(first);
+    EXPECT_EQ(second.stats().site(), testSite);
+    EXPECT_EQ(second.stats().counters().allocations, 1);
+    EXPECT_EQ(first.stats().site(), my_vec::vector_stats::untaggedSite);
+
+    first = std::move(second);
+    EXPECT_EQ(first.stats().site(), testSite);
+    EXPECT_EQ(first.stats().counters().peakCapacityBytes, numOfPushedElements * sizeof(int));
+    EXPECT_EQ(second.stats().counters().allocations, 0);
+}